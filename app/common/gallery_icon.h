@@ -22,6 +22,7 @@ public:
 
     QString path(Theme theme = Theme::Auto) const override;
     QIcon icon(Theme theme = Theme::Auto, const QColor& color = QColor()) const override;
+    using FluentIconBase::render;
     void render(QPainter* painter, const QRect& rect, Theme theme = Theme::Auto,
                 const QVariantMap& attributes = {}) const override;
     FluentIconBase* clone() const override;
@@ -1,20 +1,91 @@
 #include "common/config.h"
 
 #include <QApplication>
+#include <QEvent>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMap>
+#include <QMetaMethod>
 #include <QPalette>
+#include <QSaveFile>
 #include <QSettings>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
 
 #include "common/style_sheet.h"
 #include "common/qtcompat.h"
 
 namespace qfw {
 
+// Darkness of the application palette for Theme::Auto. isDarkTheme() runs in nearly every
+// paint, so the palette is only read again after it changes. Its application event filter is
+// the only one the library installs for palette and platform theme changes; they are passed
+// on through QConfig::applicationPaletteChanged.
+class PaletteDarknessCache final : public QObject {
+public:
+    static PaletteDarknessCache& instance() {
+        static PaletteDarknessCache cache;
+        return cache;
+    }
+
+    bool isDark() {
+        ++lookups_;
+        listen();
+
+        if (!valid_ || !listening_) {
+            ++paletteReads_;
+            dark_ = qApp->palette().color(QPalette::Window).lightnessF() < 0.5;
+            valid_ = true;
+        }
+        return dark_;
+    }
+
+    void listen() {
+        if (!listening_ && qApp) {
+            qApp->installEventFilter(this);
+            listening_ = true;
+        }
+    }
+
+    void invalidate() { valid_ = false; }
+
+    quint64 lookups() const { return lookups_; }
+    quint64 paletteReads() const { return paletteReads_; }
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override {
+        if (event->type() == QEvent::ApplicationPaletteChange ||
+            event->type() == QEvent::ThemeChange) {
+            valid_ = false;
+            // Palette changes are delivered to every widget; notify once per batch
+            if (!notifyPending_) {
+                notifyPending_ = true;
+                QMetaObject::invokeMethod(
+                    this,
+                    [this]() {
+                        notifyPending_ = false;
+                        emit QConfig::instance().applicationPaletteChanged();
+                    },
+                    Qt::QueuedConnection);
+            }
+        }
+        return QObject::eventFilter(watched, event);
+    }
+
+private:
+    bool listening_ = false;
+    bool valid_ = false;
+    bool dark_ = false;
+    bool notifyPending_ = false;
+    quint64 lookups_ = 0;
+    quint64 paletteReads_ = 0;
+};
+
 QString themeToString(Theme theme) {
     switch (theme) {
         case Theme::Light:
@@ -387,7 +458,11 @@ void QConfig::set(ConfigItem& item, const QVariant& value, bool saveToFile, bool
     item.setValue(value);
 
     if (saveToFile) {
-        save();
+        if (saveDelay_ > 0) {
+            scheduleSave(true, false);
+        } else {
+            save();
+        }
     }
 
     if (item.restart()) {
@@ -473,39 +548,145 @@ void QConfig::loadFromJson(const QString& filePath) {
     }
 }
 
-void QConfig::saveToJson(const QString& filePath) const {
-    QJsonObject root;
-    for (const auto& ptr : items_) {
-        const ConfigItem* itemPtr = ptr.data();
-        if (!itemPtr) {
-            continue;
-        }
-        const QString group = itemPtr->group();
-        const QString name = itemPtr->name();
-        const QVariant v = itemPtr->serialize();
+// Item values copied on the GUI thread, so the JSON can be built and written elsewhere
+struct ConfigEntry {
+    QString group;
+    QString name;
+    QVariant value;
+};
 
-        if (name.isEmpty()) {
-            root.insert(group, QJsonValue::fromVariant(v));
-            continue;
+static QVector<ConfigEntry> snapshotConfigItems(const QList<QPointer<ConfigItem>>& items) {
+    QVector<ConfigEntry> entries;
+    entries.reserve(items.size());
+    for (const auto& ptr : items) {
+        const ConfigItem* itemPtr = ptr.data();
+        if (itemPtr) {
+            entries.append({itemPtr->group(), itemPtr->name(), itemPtr->serialize()});
         }
+    }
+    return entries;
+}
 
-        QJsonObject groupObj;
-        if (root.contains(group) && root.value(group).isObject()) {
-            groupObj = root.value(group).toObject();
+static void writeConfigJson(const QString& filePath, const QVector<ConfigEntry>& entries) {
+    // Collect each group once instead of copying its object back and forth per item
+    QJsonObject root;
+    QMap<QString, QJsonObject> groups;
+    for (const ConfigEntry& entry : entries) {
+        if (entry.name.isEmpty()) {
+            root.insert(entry.group, QJsonValue::fromVariant(entry.value));
+        } else {
+            groups[entry.group].insert(entry.name, QJsonValue::fromVariant(entry.value));
         }
-        groupObj.insert(name, QJsonValue::fromVariant(v));
-        root.insert(group, groupObj);
+    }
+    for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
+        root.insert(it.key(), it.value());
     }
 
     QFileInfo fi(filePath);
     QDir().mkpath(fi.dir().absolutePath());
 
-    QFile f(filePath);
-    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+    // Written to a temporary file and renamed, so a crash never leaves a truncated config
+    const QByteArray data = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    QSaveFile f(filePath);
+    if (!f.open(QIODevice::WriteOnly) || f.write(data) != data.size()) {
         return;
     }
-    f.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
-    f.close();
+    f.commit();
+}
+
+void QConfig::saveToJson(const QString& filePath) const {
+    // Keep a synchronous save from being overwritten by an older background one
+    waitForPendingWrites();
+    writeConfigJson(filePath, snapshotConfigItems(items_));
+}
+
+void QConfig::setSaveDelay(int msec) {
+    saveDelay_ = qMax(0, msec);
+    if (saveDelay_ == 0) {
+        flush();
+        return;
+    }
+
+    if (!saveTimer_) {
+        saveTimer_ = new QTimer(this);
+        saveTimer_->setSingleShot(true);
+        connect(saveTimer_, &QTimer::timeout, this, &QConfig::writePending);
+
+        writer_ = new QThreadPool(this);
+        writer_->setMaxThreadCount(1);
+    }
+
+    if (QCoreApplication* app = QCoreApplication::instance()) {
+        connect(app, &QCoreApplication::aboutToQuit, this, &QConfig::flush, Qt::UniqueConnection);
+    }
+}
+
+int QConfig::saveDelay() const { return saveDelay_; }
+
+void QConfig::flush() {
+    if (saveTimer_) {
+        saveTimer_->stop();
+    }
+    writePending();
+    waitForPendingWrites();
+}
+
+void QConfig::scheduleSave(bool json, bool settings) {
+    jsonDirty_ = jsonDirty_ || json;
+    settingsDirty_ = settingsDirty_ || settings;
+
+    // The window starts at the first change, so a stream of edits still lands within it
+    if (!saveTimer_->isActive()) {
+        saveTimer_->start(saveDelay_);
+
+        // The application may not have existed yet when the delay was set
+        if (QCoreApplication* app = QCoreApplication::instance()) {
+            connect(app, &QCoreApplication::aboutToQuit, this, &QConfig::flush,
+                    Qt::UniqueConnection);
+        }
+    }
+}
+
+void QConfig::writePending() {
+    if (!jsonDirty_ && !settingsDirty_) {
+        return;
+    }
+
+    const bool writeJson = jsonDirty_;
+    const bool writeSettings = settingsDirty_;
+    jsonDirty_ = false;
+    settingsDirty_ = false;
+
+    const QString filePath = filePath_;
+    const QVector<ConfigEntry> entries =
+        writeJson ? snapshotConfigItems(items_) : QVector<ConfigEntry>();
+    const QString orgName = settingsOrgName();
+    const QString appName = settingsAppName();
+    const QString themeMode = pendingThemeMode_;
+    const QString themeColor = pendingThemeColor_;
+    pendingThemeMode_.clear();
+    pendingThemeColor_.clear();
+
+    writer_->start([=]() {
+        if (writeJson) {
+            writeConfigJson(filePath, entries);
+        }
+        if (writeSettings) {
+            QSettings s(orgName, appName);
+            if (!themeMode.isNull()) {
+                s.setValue(keyThemeMode(), themeMode);
+            }
+            if (!themeColor.isNull()) {
+                s.setValue(keyThemeColor(), themeColor);
+            }
+        }
+    });
+}
+
+void QConfig::waitForPendingWrites() const {
+    if (writer_) {
+        writer_->waitForDone();
+    }
 }
 
 void QConfig::loadThemeAndColorFromSettings() {
@@ -522,11 +703,23 @@ void QConfig::loadThemeAndColorFromSettings() {
 }
 
 void QConfig::saveThemeToSettings(Theme theme) {
+    if (saveDelay_ > 0) {
+        pendingThemeMode_ = themeToString(theme);
+        scheduleSave(false, true);
+        return;
+    }
+
     QSettings s(settingsOrgName(), settingsAppName());
     s.setValue(keyThemeMode(), themeToString(theme));
 }
 
 void QConfig::saveThemeColorToSettings(const QColor& color) {
+    if (saveDelay_ > 0) {
+        pendingThemeColor_ = color.name(QColor::HexArgb);
+        scheduleSave(false, true);
+        return;
+    }
+
     QSettings s(settingsOrgName(), settingsAppName());
     s.setValue(keyThemeColor(), color.name(QColor::HexArgb));
 }
@@ -561,6 +754,7 @@ void QConfig::setTheme(Theme theme, bool emitSignal) {
     }
 
     theme_ = theme;
+    PaletteDarknessCache::instance().invalidate();
 
     saveThemeToSettings(theme_);
 
@@ -571,6 +765,13 @@ void QConfig::setTheme(Theme theme, bool emitSignal) {
 
 void QConfig::notifyThemeChangedFinished() { emit themeChangedFinished(); }
 
+void QConfig::connectNotify(const QMetaMethod& signal) {
+    if (signal == QMetaMethod::fromSignal(&QConfig::applicationPaletteChanged)) {
+        PaletteDarknessCache::instance().listen();
+    }
+    QObject::connectNotify(signal);
+}
+
 QColor QConfig::themeColor() const { return themeColor_; }
 
 void QConfig::setThemeColor(const QColor& color, bool emitSignal) {
@@ -587,6 +788,11 @@ void QConfig::setThemeColor(const QColor& color, bool emitSignal) {
     }
 }
 
+void isDarkThemeStats(quint64* lookups, quint64* paletteReads) {
+    *lookups = PaletteDarknessCache::instance().lookups();
+    *paletteReads = PaletteDarknessCache::instance().paletteReads();
+}
+
 bool isDarkTheme() {
     auto t = QConfig::instance().theme();
     if (t == Theme::Dark) {
@@ -597,8 +803,7 @@ bool isDarkTheme() {
         return false;
     }
 
-    const QColor c = qApp->palette().color(QPalette::Window);
-    return c.lightnessF() < 0.5;
+    return PaletteDarknessCache::instance().isDark();
 }
 
 Theme theme() { return QConfig::instance().theme(); }
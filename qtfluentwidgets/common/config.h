@@ -17,6 +17,9 @@
 #include <QVariant>
 #include <memory>
 
+class QThreadPool;
+class QTimer;
+
 namespace qfw {
 
 enum class Theme { Light, Dark, Auto };
@@ -208,6 +211,16 @@ public:
     void save() const;
     void save(const QString& filePath) const;
 
+    // Write-behind persistence: changes made through set(), setTheme() and setThemeColor()
+    // within |msec| of the first one are coalesced into a single write on a background thread.
+    // 0 (the default) saves synchronously on every change. Pending changes are flushed on
+    // QCoreApplication::aboutToQuit, also when the application is created after this call.
+    void setSaveDelay(int msec);
+    int saveDelay() const;
+
+    // Writes pending changes now and waits until every background write has finished.
+    void flush();
+
     QVariant get(const ConfigItem& item) const;
     void set(ConfigItem& item, const QVariant& value, bool saveToFile = true,
              bool emitSignal = true, bool lazyUpdate = false);
@@ -233,6 +246,12 @@ signals:
     void themeChanged(qfw::Theme theme);
     void themeChangedFinished();
     void themeColorChanged(const QColor& color);
+    // The application palette or the platform theme changed; emitted once per batch of
+    // change events from the library's application event filter.
+    void applicationPaletteChanged();
+
+protected:
+    void connectNotify(const QMetaMethod& signal) override;
 
 private:
     explicit QConfig(QObject* parent = nullptr);
@@ -251,6 +270,10 @@ private:
     void loadFromJson(const QString& filePath);
     void saveToJson(const QString& filePath) const;
 
+    void scheduleSave(bool json, bool settings);
+    void writePending();
+    void waitForPendingWrites() const;
+
     QString filePath_;
     QPointer<OptionsConfigItem> themeMode_;
     QPointer<ColorConfigItem> themeColorItem_;
@@ -258,10 +281,21 @@ private:
 
     Theme theme_;
     QColor themeColor_;
+
+    int saveDelay_ = 0;
+    bool jsonDirty_ = false;
+    bool settingsDirty_ = false;
+    QString pendingThemeMode_;   // values to write to QSettings, null if unchanged
+    QString pendingThemeColor_;
+    QTimer* saveTimer_ = nullptr;
+    QThreadPool* writer_ = nullptr;  // one thread, so writes land in order
 };
 
 bool isDarkTheme();
 
+// isDarkTheme() calls and application palette reads so far, for the QFW_QSS_DEBUG stats dump
+void isDarkThemeStats(quint64* lookups, quint64* paletteReads);
+
 Theme theme();
 bool isDarkThemeMode(Theme theme = Theme::Auto);
 
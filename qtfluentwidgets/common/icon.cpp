@@ -4,18 +4,28 @@
 #include <qpainterpath.h>
 
 #include <QAction>
+#include <QCache>
 #include <QColor>
 #include <QFile>
 #include <QFontDatabase>
+#include <QGlyphRun>
 #include <QGuiApplication>
+#include <QHash>
 #include <QIcon>
+#include <QMap>
 #include <QMenu>
-#include <QRegularExpression>
+#include <QRawFont>
 #include <QSet>
+#include <QSharedPointer>
+#include <QVector>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 #include <QtSvg/QSvgRenderer>
 #include <cmath>
+#include <utility>
+
+#include "common/icon_cache.h"
+#include "common/style_sheet.h"
 
 namespace qfw {
 
@@ -24,23 +34,22 @@ namespace qfw {
 // ============================================================================
 
 FluentIconEngine::FluentIconEngine(const FluentIconBase* icon, bool reverse)
-    : icon_(icon ? icon->clone() : nullptr), isThemeReversed_(reverse), ownsIcon_(true) {}
+    : icon_(icon ? icon->clone() : nullptr), isThemeReversed_(reverse) {}
 
 FluentIconEngine::FluentIconEngine(const FluentIconBase& icon, bool reverse)
-    : icon_(icon.clone()), isThemeReversed_(reverse), ownsIcon_(true) {}
+    : icon_(icon.clone()), isThemeReversed_(reverse) {}
 
-FluentIconEngine::~FluentIconEngine() {
-    if (ownsIcon_ && icon_) {
-        delete icon_;
-        icon_ = nullptr;
-    }
-}
+FluentIconEngine::FluentIconEngine(const QSharedPointer<const FluentIconBase>& icon, bool reverse)
+    : icon_(icon), isThemeReversed_(reverse) {}
 
 void FluentIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode mode,
                              QIcon::State state) {
-    painter->save();
+    if (!icon_) {
+        return;
+    }
 
     // Handle disabled/selected modes with opacity
+    const qreal opacity = painter->opacity();
     if (mode == QIcon::Disabled) {
         painter->setOpacity(0.5);
     } else if (mode == QIcon::Selected) {
@@ -57,32 +66,46 @@ void FluentIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode m
     }
 
     // Render the icon
-    if (icon_) {
-        QVariantMap attributes;
-        if (isThemeReversed_) {
-            attributes.insert(QStringLiteral("reverse"), true);
-        }
-        icon_->render(painter, adjustedRect, theme, attributes);
-    }
+    IconRenderOptions options;
+    options.reverse = isThemeReversed_;
+    icon_->render(painter, adjustedRect, theme, options);
 
-    painter->restore();
+    painter->setOpacity(opacity);
 }
 
 QIconEngine* FluentIconEngine::clone() const {
-    // Clone with ownership of the icon
     return new FluentIconEngine(icon_, isThemeReversed_);
 }
 
 QPixmap FluentIconEngine::pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) {
-    QImage image(size, QImage::Format_ARGB32);
+    const quint64 themeKey =
+        (static_cast<quint64>(themeColor().rgba()) << 1) | (isDarkTheme() ? 1 : 0);
+    if (themeKey != pixmapThemeKey_) {
+        pixmaps_.clear();
+        pixmapThemeKey_ = themeKey;
+    }
+
+    const quint64 key = (static_cast<quint64>(size.width()) << 32) |
+                        (static_cast<quint64>(size.height() & 0xffff) << 16) |
+                        (static_cast<quint64>(mode) << 4) | static_cast<quint64>(state);
+    auto it = pixmaps_.constFind(key);
+    if (it != pixmaps_.constEnd()) {
+        return it.value();
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
     image.fill(Qt::transparent);
-    QPixmap pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
 
-    QPainter painter(&pixmap);
-    QRect rect(0, 0, size.width(), size.height());
-    paint(&painter, rect, mode, state);
+    QPainter painter(&image);
+    paint(&painter, QRect(QPoint(0, 0), size), mode, state);
     painter.end();
 
+    // A QIcon usually asks for one or two sizes, so a handful of entries is plenty
+    if (pixmaps_.size() >= 8) {
+        pixmaps_.clear();
+    }
+    const QPixmap pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
+    pixmaps_.insert(key, pixmap);
     return pixmap;
 }
 
@@ -96,10 +119,17 @@ SvgIconEngine::SvgIconEngine(const QByteArray& svgData) : svgData_(svgData) {}
 
 void SvgIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode mode,
                           QIcon::State state) {
-    drawSvgIcon(svgData_, painter, rect);
+    if (!renderer_) {
+        renderer_.reset(new QSvgRenderer(svgData_));
+    }
+    renderer_->render(painter, QRectF(rect));
 }
 
-QIconEngine* SvgIconEngine::clone() const { return new SvgIconEngine(svgData_); }
+QIconEngine* SvgIconEngine::clone() const {
+    SvgIconEngine* engine = new SvgIconEngine(svgData_);
+    engine->renderer_ = renderer_;
+    return engine;
+}
 
 QPixmap SvgIconEngine::pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) {
     QImage image(size, QImage::Format_ARGB32);
@@ -122,20 +152,59 @@ FontIconEngine::FontIconEngine(const QString& fontFamily, const QString& charact
                                const QColor& color, bool bold)
     : fontFamily_(fontFamily), character_(character), color_(color), isBold_(bold) {}
 
+struct FontGlyphKey {
+    QString family;
+    QString character;
+    bool bold;
+    int pixelSize;
+
+    bool operator==(const FontGlyphKey& other) const {
+        return pixelSize == other.pixelSize && bold == other.bold &&
+               character == other.character && family == other.family;
+    }
+};
+
+static qHash_result_type qHash(const FontGlyphKey& key, qHash_result_type seed = 0) {
+    return qHash(key.family, seed) ^ (qHash(key.character, seed) * 31) ^
+           static_cast<qHash_result_type>((key.pixelSize << 1) | (key.bold ? 1 : 0));
+}
+
+// Glyph outline with its baseline at (0, pixelSize); extracting it from the font engine is
+// the expensive part of drawing a font icon.
+static QPainterPath fontIconPath(const QString& family, const QString& character, bool bold,
+                                 int pixelSize) {
+    static QCache<FontGlyphKey, QPainterPath> cache(512);
+
+    const FontGlyphKey key{family, character, bold, pixelSize};
+    if (const QPainterPath* path = cache.object(key)) {
+        return *path;
+    }
+
+    QFont font(family);
+    font.setBold(bold);
+    font.setPixelSize(pixelSize);
+
+    QPainterPath* path = new QPainterPath;
+    path->addText(0, pixelSize, font, character);
+    const QPainterPath result = *path;
+    cache.insert(key, path);
+    return result;
+}
+
 void FontIconEngine::paint(QPainter* painter, const QRect& rect, QIcon::Mode mode,
                            QIcon::State state) {
-    QFont font(fontFamily_);
-    font.setBold(isBold_);
-    font.setPixelSize(static_cast<int>(std::round(rect.height())));
+    const int pixelSize = static_cast<int>(std::round(rect.height()));
+    if (pixelSize <= 0) {
+        return;
+    }
 
-    painter->setFont(font);
     painter->setPen(Qt::NoPen);
     painter->setBrush(color_);
     painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
 
-    QPainterPath path;
-    path.addText(rect.x(), rect.y() + rect.height(), font, character_);
-    painter->drawPath(path);
+    painter->translate(rect.topLeft());
+    painter->drawPath(fontIconPath(fontFamily_, character_, isBold_, pixelSize));
+    painter->translate(-rect.topLeft());
 }
 
 QIconEngine* FontIconEngine::clone() const {
@@ -159,9 +228,223 @@ QPixmap FontIconEngine::pixmap(const QSize& size, QIcon::Mode mode, QIcon::State
 // Helper Functions
 // ============================================================================
 
+// An svg file read once, with the attribute spans of every <path> tag recorded so recoloring
+// is a splice at known offsets instead of a regex pass over the text.
+struct SvgDocument {
+    struct Attribute {
+        QString name;
+        int start = 0;  // includes the leading whitespace
+        int length = 0;
+    };
+
+    struct PathNode {
+        int insertPos = 0;  // before the closing '>' or '/>'
+        QVector<Attribute> attributes;
+    };
+
+    QString source;
+    QVector<PathNode> paths;
+    bool monochrome = false;  // a single paint color, so it can be tinted as an alpha mask
+};
+
+static bool isMonochromeSvg(const QString& source) {
+    // Gradients, patterns, embedded images and CSS colors are out of reach of a simple scan
+    for (const char* marker : {"Gradient", "<pattern", "<image", "url(", "fill:", "stroke:",
+                               "stop-color", "currentColor"}) {
+        if (source.contains(QLatin1String(marker))) {
+            return false;
+        }
+    }
+
+    QString color;
+    for (const char* attr : {"fill=", "stroke="}) {
+        const QLatin1String name(attr);
+        int pos = 0;
+        while ((pos = static_cast<int>(source.indexOf(name, pos))) != -1) {
+            pos += name.size();
+            if (pos >= source.size() ||
+                (source.at(pos) != QLatin1Char('"') && source.at(pos) != QLatin1Char('\''))) {
+                continue;
+            }
+
+            const int end = static_cast<int>(source.indexOf(source.at(pos), pos + 1));
+            if (end == -1) {
+                return false;
+            }
+            const QString value = source.mid(pos + 1, end - pos - 1).trimmed().toLower();
+            pos = end + 1;
+            if (value.isEmpty() || value == QLatin1String("none")) {
+                continue;
+            }
+            if (color.isEmpty()) {
+                color = value;
+            } else if (color != value) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static SvgDocument parseSvgDocument(const QString& source) {
+    SvgDocument doc;
+    doc.source = source;
+    doc.monochrome = isMonochromeSvg(source);
+
+    const QChar* s = source.constData();
+    const int n = static_cast<int>(source.size());
+    int pos = 0;
+    while ((pos = static_cast<int>(source.indexOf(QLatin1String("<path"), pos))) != -1) {
+        int i = pos + 5;
+        if (i < n && !s[i].isSpace() && s[i] != QLatin1Char('/') && s[i] != QLatin1Char('>')) {
+            pos = i;  // e.g. <pathology>, not a path element
+            continue;
+        }
+
+        SvgDocument::PathNode node;
+        bool closed = false;
+        while (i < n) {
+            const int attrStart = i;
+            while (i < n && s[i].isSpace()) {
+                ++i;
+            }
+            if (i >= n) {
+                break;
+            }
+            if (s[i] == QLatin1Char('>') ||
+                (s[i] == QLatin1Char('/') && i + 1 < n && s[i + 1] == QLatin1Char('>'))) {
+                node.insertPos = i;
+                closed = true;
+                break;
+            }
+
+            const int nameStart = i;
+            while (i < n && !s[i].isSpace() && s[i] != QLatin1Char('=') &&
+                   s[i] != QLatin1Char('>') && s[i] != QLatin1Char('/')) {
+                ++i;
+            }
+            const int nameEnd = i;
+            while (i < n && s[i].isSpace()) {
+                ++i;
+            }
+            if (i >= n || s[i] != QLatin1Char('=')) {
+                if (nameEnd == nameStart) {
+                    ++i;  // stray character
+                }
+                continue;
+            }
+
+            ++i;
+            while (i < n && s[i].isSpace()) {
+                ++i;
+            }
+            if (i >= n || (s[i] != QLatin1Char('"') && s[i] != QLatin1Char('\''))) {
+                continue;
+            }
+
+            const int valueEnd = static_cast<int>(source.indexOf(s[i], i + 1));
+            if (valueEnd == -1) {
+                break;
+            }
+            i = valueEnd + 1;
+            node.attributes.append(SvgDocument::Attribute{
+                source.mid(nameStart, nameEnd - nameStart), attrStart, i - attrStart});
+        }
+
+        if (!closed) {
+            break;
+        }
+        doc.paths.append(node);
+        pos = node.insertPos;
+    }
+
+    return doc;
+}
+
+static QSharedPointer<const SvgDocument> svgDocument(const QString& iconPath) {
+    static QHash<QString, QSharedPointer<const SvgDocument>> cache;
+    auto it = cache.constFind(iconPath);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    QFile file(iconPath);
+    if (!file.open(QFile::ReadOnly)) {
+        return {};
+    }
+
+    QSharedPointer<const SvgDocument> doc(
+        new SvgDocument(parseSvgDocument(QString::fromUtf8(file.readAll()))));
+    cache.insert(iconPath, doc);
+    return doc;
+}
+
+// Parsing the document dominates drawing it, so keep one renderer per svg source.
+static QCache<QString, QSvgRenderer>& svgRendererCache() {
+    static QCache<QString, QSvgRenderer> c(256);
+    return c;
+}
+
 void drawSvgIcon(const QString& iconPath, QPainter* painter, const QRect& rect) {
-    QSvgRenderer renderer(iconPath);
-    renderer.render(painter, QRectF(rect));
+    QSvgRenderer* renderer = svgRendererCache().object(iconPath);
+    if (!renderer) {
+        renderer = new QSvgRenderer(iconPath);
+        svgRendererCache().insert(iconPath, renderer);
+    }
+    renderer->render(painter, QRectF(rect));
+}
+
+void drawFontIcons(QPainter* painter, const QString& fontFamily, const QColor& color, bool bold,
+                   const QVector<FontIconGlyph>& glyphs) {
+    struct Run {
+        QRawFont font;
+        QVector<quint32> indexes;
+        QVector<QPointF> positions;
+    };
+
+    // One run per pixel size; each glyph sits on the baseline at the bottom of its rect, as in
+    // FontIconEngine::paint
+    QMap<int, Run> runs;
+    for (const FontIconGlyph& glyph : glyphs) {
+        const int pixelSize = glyph.rect.height();
+        if (pixelSize <= 0 || glyph.character.isEmpty()) {
+            continue;
+        }
+
+        auto run = runs.find(pixelSize);
+        if (run == runs.end()) {
+            QFont font(fontFamily);
+            font.setBold(bold);
+            font.setPixelSize(pixelSize);
+            run = runs.insert(pixelSize, Run{QRawFont::fromFont(font), {}, {}});
+        }
+
+        const QVector<quint32> indexes = run->font.glyphIndexesForString(glyph.character);
+        const QVector<QPointF> advances = run->font.advancesForGlyphIndexes(indexes);
+        QPointF position(glyph.rect.x(), glyph.rect.y() + glyph.rect.height());
+        for (int i = 0; i < indexes.size(); ++i) {
+            run->indexes.append(indexes.at(i));
+            run->positions.append(position);
+            position.rx() += advances.at(i).x();
+        }
+    }
+
+    if (runs.isEmpty()) {
+        return;
+    }
+
+    painter->save();
+    painter->setPen(color);
+    painter->setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing);
+    for (const Run& run : std::as_const(runs)) {
+        QGlyphRun glyphRun;
+        glyphRun.setRawFont(run.font);
+        glyphRun.setGlyphIndexes(run.indexes);
+        glyphRun.setPositions(run.positions);
+        painter->drawGlyphRun(QPointF(0, 0), glyphRun);
+    }
+    painter->restore();
 }
 
 void drawSvgIcon(const QByteArray& iconData, QPainter* painter, const QRect& rect) {
@@ -169,6 +452,211 @@ void drawSvgIcon(const QByteArray& iconData, QPainter* painter, const QRect& rec
     renderer.render(painter, QRectF(rect));
 }
 
+static QString iconAttributesKey(const QVariantMap& attributes) {
+    QString key;
+    for (auto it = attributes.constBegin(); it != attributes.constEnd(); ++it) {
+        key += it.key() + QLatin1Char('=') + it.value().toString() + QLatin1Char(';');
+    }
+    return key;
+}
+
+// Draws the svg at |iconPath| with |attributes| applied to its paths. Each recolored variant
+// is patched and parsed once, then its renderer is reused.
+static void drawSvgSource(QPainter* painter, const QRect& rect, const QString& iconPath,
+                          const QVariantMap& attributes) {
+    if (!attributes.isEmpty()) {
+        const QString variantKey = iconPath + QLatin1Char('|') + iconAttributesKey(attributes);
+        QSvgRenderer* renderer = svgRendererCache().object(variantKey);
+        if (!renderer) {
+            const QString svg = writeSvg(iconPath, QList<int>(), attributes);
+            if (!svg.isEmpty()) {
+                renderer = new QSvgRenderer(svg.toUtf8());
+                svgRendererCache().insert(variantKey, renderer);
+            }
+        }
+
+        if (renderer) {
+            renderer->render(painter, QRectF(rect));
+            return;
+        }
+    }
+
+    drawSvgIcon(iconPath, painter, rect);
+}
+
+// Converts an attribute map that only sets fill/stroke/reverse; anything else has to go
+// through writeSvg as is.
+static bool toRenderOptions(const QVariantMap& attributes, IconRenderOptions* options) {
+    for (auto it = attributes.constBegin(); it != attributes.constEnd(); ++it) {
+        if (it.key() == QLatin1String("reverse")) {
+            options->reverse = it.value().toBool();
+            continue;
+        }
+
+        const QColor color(it.value().toString());
+        if (!color.isValid()) {
+            return false;
+        }
+        if (it.key() == QLatin1String("fill")) {
+            options->fill = color;
+        } else if (it.key() == QLatin1String("stroke")) {
+            options->stroke = color;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static QVariantMap toAttributes(const IconRenderOptions& options) {
+    QVariantMap attributes;
+    if (options.fill.isValid()) {
+        attributes.insert(QStringLiteral("fill"), options.fill.name());
+    }
+    if (options.stroke.isValid()) {
+        attributes.insert(QStringLiteral("stroke"), options.stroke.name());
+    }
+    return attributes;
+}
+
+// The one color |options| paints every path with, or an invalid color if fill and stroke differ.
+static QColor uniformTintColor(const IconRenderOptions& options) {
+    if (options.fill.isValid() && options.stroke.isValid() && options.fill != options.stroke) {
+        return QColor();
+    }
+    return options.fill.isValid() ? options.fill : options.stroke;
+}
+
+static QPixmap rasterizeSvgSource(const QString& iconPath, const QVariantMap& attributes,
+                                  const QSize& size, qreal devicePixelRatio) {
+    const QSize deviceSize = (QSizeF(size) * devicePixelRatio).toSize();
+    QImage image(deviceSize, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    QPainter painter(&image);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+    drawSvgSource(&painter, image.rect(), iconPath, attributes);
+    painter.end();
+
+    QPixmap pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
+    pixmap.setDevicePixelRatio(devicePixelRatio);
+    return pixmap;
+}
+
+// |attributes| is only for maps toRenderOptions() can't express; otherwise it is empty and the
+// colors come from |options|.
+static QPixmap cachedSvgPixmap(const QString& iconPath, const IconRenderOptions& options,
+                               const QVariantMap& attributes, const QSize& size,
+                               qreal devicePixelRatio) {
+    FluentIconCache& cache = FluentIconCache::instance();
+
+    FluentIconCache::Key key;
+    key.source = iconPath;
+    if (!attributes.isEmpty()) {
+        key.attributes = iconAttributesKey(attributes);
+    }
+    key.fill = options.fill;
+    key.stroke = options.stroke;
+    key.size = size;
+    key.devicePixelRatio = devicePixelRatio;
+
+    QPixmap pixmap;
+    if (cache.find(key, &pixmap)) {
+        return pixmap;
+    }
+
+    // Monochrome glyphs: tint the untouched rendering, used as an alpha mask, instead of
+    // patching and parsing one svg per color
+    const QColor tint = cache.colorizeByComposition() && attributes.isEmpty()
+                            ? uniformTintColor(options)
+                            : QColor();
+    const QSharedPointer<const SvgDocument> doc =
+        tint.isValid() ? svgDocument(iconPath) : QSharedPointer<const SvgDocument>();
+    if (doc && doc->monochrome) {
+        const QPixmap mask = cachedSvgPixmap(iconPath, IconRenderOptions(), QVariantMap(), size,
+                                             devicePixelRatio);
+        QImage image = mask.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+        QPainter painter(&image);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceIn);
+        painter.fillRect(image.rect(), tint);
+        painter.end();
+
+        pixmap = QPixmap::fromImage(image, Qt::NoFormatConversion);
+        pixmap.setDevicePixelRatio(devicePixelRatio);
+    } else {
+        pixmap = rasterizeSvgSource(iconPath, attributes.isEmpty() ? toAttributes(options) : attributes,
+                                    size, devicePixelRatio);
+    }
+
+    cache.insert(key, pixmap);
+    return pixmap;
+}
+
+// Same as drawSvgSource(), but rasterizes once per size/DPR and reuses the pixmap afterwards.
+static void drawCachedSvgIcon(QPainter* painter, const QRect& rect, const QString& iconPath,
+                              const IconRenderOptions& options,
+                              const QVariantMap& attributes = QVariantMap()) {
+    if (rect.isEmpty() || !FluentIconCache::canCache(painter)) {
+        drawSvgSource(painter, rect, iconPath,
+                      attributes.isEmpty() ? toAttributes(options) : attributes);
+        return;
+    }
+
+    // Plain glyphs share atlas sheets; recolored ones get their own cached pixmap
+    const bool plain = attributes.isEmpty() && !options.fill.isValid() && !options.stroke.isValid();
+    if (plain && IconAtlas::instance().drawIcon(painter, rect, iconPath)) {
+        return;
+    }
+
+    painter->drawPixmap(rect, cachedSvgPixmap(iconPath, options, attributes, rect.size(),
+                                              painter->device()->devicePixelRatioF()));
+}
+
+static void drawCachedSvgIcon(QPainter* painter, const QRect& rect, const QString& iconPath,
+                              const QVariantMap& attributes) {
+    IconRenderOptions options;
+    if (toRenderOptions(attributes, &options)) {
+        drawCachedSvgIcon(painter, rect, iconPath, options);
+    } else {
+        drawCachedSvgIcon(painter, rect, iconPath, IconRenderOptions(), attributes);
+    }
+}
+
+// Engine for fluent icons recolored to a fixed color; paints through the pixmap cache.
+class TintedSvgIconEngine : public QIconEngine {
+public:
+    TintedSvgIconEngine(const QString& iconPath, const IconRenderOptions& options)
+        : iconPath_(iconPath), options_(options) {}
+
+    void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode,
+               QIcon::State state) override {
+        drawCachedSvgIcon(painter, rect, iconPath_, options_);
+    }
+
+    QIconEngine* clone() const override { return new TintedSvgIconEngine(iconPath_, options_); }
+
+    QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override {
+        return cachedSvgPixmap(iconPath_, options_, QVariantMap(), size, 1.0);
+    }
+
+private:
+    QString iconPath_;
+    IconRenderOptions options_;
+};
+
+static QIcon recoloredSvgIcon(const QString& iconPath, const QColor& fill,
+                              const QColor& stroke = QColor()) {
+    if (!svgDocument(iconPath)) {
+        return QIcon(iconPath);
+    }
+
+    IconRenderOptions options;
+    options.fill = fill;
+    options.stroke = stroke;
+    return QIcon(new TintedSvgIconEngine(iconPath, options));
+}
+
 QString getIconColor(Theme theme, bool reverse) {
     QString lightColor = reverse ? QStringLiteral("white") : QStringLiteral("black");
     QString darkColor = reverse ? QStringLiteral("black") : QStringLiteral("white");
@@ -182,72 +670,58 @@ QString getIconColor(Theme theme, bool reverse) {
 
 QString writeSvg(const QString& iconPath, const QList<int>& indexes,
                  const QVariantMap& attributes) {
-    if (!iconPath.toLower().endsWith(QStringLiteral(".svg"))) {
+    if (!iconPath.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive)) {
         return QString();
     }
 
-    QFile file(iconPath);
-    if (!file.open(QFile::ReadOnly)) {
+    const QSharedPointer<const SvgDocument> doc = svgDocument(iconPath);
+    if (!doc) {
         return QString();
     }
 
-    QString svgContent = QString::fromUtf8(file.readAll());
-    file.close();
-
     if (attributes.isEmpty()) {
-        return svgContent;
+        return doc->source;
     }
 
     // Apply attributes to <path> elements.
     // If indexes is empty -> apply to all paths (legacy behavior)
     // If indexes not empty -> apply only to selected paths by 0-based order
-    QString modifiedSvg = svgContent;
     QSet<int> indexSet;
-    if (!indexes.isEmpty()) {
-        for (int idx : indexes) {
-            indexSet.insert(idx);
-        }
+    for (int idx : indexes) {
+        indexSet.insert(idx);
     }
 
-    QRegularExpression pathStartRe(QStringLiteral("<path"));
-    int offset = 0;
-    int pathIndex = 0;
-    QRegularExpressionMatch match;
-    while ((match = pathStartRe.match(modifiedSvg, offset)).hasMatch()) {
-        const int tagStart = match.capturedStart();
-        int tagEnd = modifiedSvg.indexOf(QStringLiteral(">"), tagStart);
-        if (tagEnd == -1) {
-            break;
-        }
-
-        const bool shouldApply = indexSet.isEmpty() || indexSet.contains(pathIndex);
-        QString tag = modifiedSvg.mid(tagStart, tagEnd - tagStart + 1);
+    QString added;
+    for (auto it = attributes.constBegin(); it != attributes.constEnd(); ++it) {
+        added += QStringLiteral(" %1=\"%2\"").arg(it.key(), it.value().toString());
+    }
 
-        if (shouldApply) {
-            // Remove and re-insert provided attributes
-            for (auto it = attributes.begin(); it != attributes.end(); ++it) {
-                const QString attrName = it.key();
-                const QString attrValue = it.value().toString();
+    const QString& source = doc->source;
+    QString result;
+    result.reserve(source.size() + doc->paths.size() * added.size());
 
-                QRegularExpression existingAttrRe(
-                    QStringLiteral("\\s%1\\s*=\\s*\"[^\"]*\"").arg(attrName));
-                tag.remove(existingAttrRe);
+    int copied = 0;
+    for (int p = 0; p < doc->paths.size(); ++p) {
+        if (!indexSet.isEmpty() && !indexSet.contains(p)) {
+            continue;
+        }
 
-                const QString attrPair = QStringLiteral(" %1=\"%2\"").arg(attrName, attrValue);
-                int insertPos = tag.lastIndexOf(QStringLiteral(">"));
-                if (insertPos > 0 && tag.at(insertPos - 1) == QLatin1Char('/')) {
-                    insertPos--;  // Move before the '/' in '/>'
-                }
-                tag.insert(insertPos, attrPair);
+        // Drop the attributes being replaced, then append the new values
+        const SvgDocument::PathNode& node = doc->paths.at(p);
+        for (const SvgDocument::Attribute& attr : node.attributes) {
+            if (attributes.contains(attr.name)) {
+                result.append(source.constData() + copied, attr.start - copied);
+                copied = attr.start + attr.length;
             }
         }
 
-        modifiedSvg.replace(tagStart, tagEnd - tagStart + 1, tag);
-        offset = tagStart + tag.length();
-        ++pathIndex;
+        result.append(source.constData() + copied, node.insertPos - copied);
+        result += added;
+        copied = node.insertPos;
     }
+    result.append(source.constData() + copied, source.size() - copied);
 
-    return modifiedSvg;
+    return result;
 }
 
 QIcon toQIcon(const FluentIconBase& icon) { return icon.icon(); }
@@ -261,17 +735,9 @@ QIcon toQIcon(const QString& iconPath) { return QIcon(iconPath); }
 QIcon FluentIconBase::icon(Theme theme, const QColor& color) const {
     QString iconPath = path(theme);
 
-    // If it's an SVG with a custom color, use SvgIconEngine
+    // If it's an SVG with a custom color, tint it through the icon cache
     if (iconPath.endsWith(QStringLiteral(".svg")) && color.isValid()) {
-        QVariantMap attributes;
-        attributes.insert(QStringLiteral("fill"), color.name());
-        attributes.insert(QStringLiteral("stroke"), color.name());
-        const QString svg = writeSvg(iconPath, QList<int>(), attributes);
-        if (!svg.isEmpty()) {
-            return QIcon(new SvgIconEngine(svg.toUtf8()));
-        }
-
-        return QIcon(new SvgIconEngine(iconPath));
+        return recoloredSvgIcon(iconPath, color, color);
     }
 
     return QIcon(iconPath);
@@ -287,12 +753,7 @@ void FluentIconBase::render(QPainter* painter, const QRect& rect, Theme theme,
 
     if (iconPath.endsWith(QStringLiteral(".svg"))) {
         // Apply attributes (like fill color) to SVG before drawing
-        QString svg = writeSvg(iconPath, QList<int>(), attributes);
-        if (!svg.isEmpty()) {
-            drawSvgIcon(svg.toUtf8(), painter, rect);
-        } else {
-            drawSvgIcon(iconPath, painter, rect);
-        }
+        drawCachedSvgIcon(painter, rect, iconPath, attributes);
     } else {
         // For non-SVG icons, use QIcon
         QIcon icon(iconPath);
@@ -300,6 +761,15 @@ void FluentIconBase::render(QPainter* painter, const QRect& rect, Theme theme,
     }
 }
 
+void FluentIconBase::render(QPainter* painter, const QRect& rect, Theme theme,
+                            const IconRenderOptions& options) const {
+    QVariantMap attributes = toAttributes(options);
+    if (options.reverse) {
+        attributes.insert(QStringLiteral("reverse"), true);
+    }
+    render(painter, rect, theme, attributes);
+}
+
 ColoredFluentIcon* FluentIconBase::colored(const QColor& lightColor,
                                            const QColor& darkColor) const {
     return new ColoredFluentIcon(this, lightColor, darkColor);
@@ -337,15 +807,7 @@ QIcon ColoredFluentIcon::icon(Theme theme, const QColor& color) const {
                                               ? (isDarkTheme() ? darkColor_ : lightColor_)
                                               : (theme == Theme::Dark ? darkColor_ : lightColor_));
 
-    QVariantMap attributes;
-    attributes[QStringLiteral("fill")] = fillColor.name();
-    QString modifiedSvg = writeSvg(iconPath, QList<int>(), attributes);
-
-    if (!modifiedSvg.isEmpty()) {
-        return QIcon(new SvgIconEngine(modifiedSvg.toUtf8()));
-    }
-
-    return QIcon(iconPath);
+    return recoloredSvgIcon(iconPath, fillColor);
 }
 
 void ColoredFluentIcon::render(QPainter* painter, const QRect& rect, Theme theme,
@@ -362,26 +824,44 @@ void ColoredFluentIcon::render(QPainter* painter, const QRect& rect, Theme theme
         return;
     }
 
+    IconRenderOptions options;
+    if (toRenderOptions(attributes, &options)) {
+        render(painter, rect, theme, options);
+        return;
+    }
+
     // Determine color based on theme
-    QColor fillColor;
     QVariantMap finalAttributes = attributes;
-
-    if (attributes.contains(QStringLiteral("fill"))) {
-        fillColor = QColor(attributes.value(QStringLiteral("fill")).toString());
-    } else {
-        fillColor = (theme == Theme::Auto) ? (isDarkTheme() ? darkColor_ : lightColor_)
-                                           : (theme == Theme::Dark ? darkColor_ : lightColor_);
+    if (!attributes.contains(QStringLiteral("fill"))) {
+        const QColor fillColor = (theme == Theme::Auto)
+                                     ? (isDarkTheme() ? darkColor_ : lightColor_)
+                                     : (theme == Theme::Dark ? darkColor_ : lightColor_);
         finalAttributes[QStringLiteral("fill")] = fillColor.name();
     }
 
     // Modify SVG with color
-    QString modifiedSvg = writeSvg(iconPath, QList<int>(), finalAttributes);
-    if (!modifiedSvg.isEmpty()) {
-        drawSvgIcon(modifiedSvg.toUtf8(), painter, rect);
-    } else {
-        // Fallback to original
-        drawSvgIcon(iconPath, painter, rect);
+    drawCachedSvgIcon(painter, rect, iconPath, IconRenderOptions(), finalAttributes);
+}
+
+void ColoredFluentIcon::render(QPainter* painter, const QRect& rect, Theme theme,
+                               const IconRenderOptions& options) const {
+    if (!fluentIcon_) {
+        return;
     }
+
+    const QString iconPath = path(theme);
+    if (!iconPath.endsWith(QStringLiteral(".svg"))) {
+        QIcon icon(iconPath);
+        painter->drawPixmap(rect, icon.pixmap(rect.size()));
+        return;
+    }
+
+    IconRenderOptions colored = options;
+    if (!colored.fill.isValid()) {
+        colored.fill = (theme == Theme::Auto) ? (isDarkTheme() ? darkColor_ : lightColor_)
+                                              : (theme == Theme::Dark ? darkColor_ : lightColor_);
+    }
+    drawCachedSvgIcon(painter, rect, iconPath, colored);
 }
 
 FluentIconBase* ColoredFluentIcon::clone() const {
@@ -452,26 +932,279 @@ void Action::setIcon(const FluentIconBase& icon) {
 // FluentIcon
 // ============================================================================
 
-FluentIcon::FluentIcon(FluentIconEnum icon) : icon_(icon) {}
+// Resource base names indexed by FluentIconEnum; a few enumerators share a glyph.
+static constexpr const char* kFluentIconNames[] = {
+    // Navigation
+    "Up",
+    "Down",
+    "ChevronDown",
+    "ChevronRight",
+    "CareUpSolid",
+    "CareDownSolid",
+    "CareLeftSolid",
+    "CareRightSolid",
+    "LeftArrow",
+    "RightArrow",
+    "ChevronDown",  // ArrowDown
+    // Actions
+    "Add",
+    "Remove",
+    "Delete",
+    "Edit",
+    "Save",
+    "Cancel",
+    "Accept",
+    "Copy",
+    "Paste",
+    "Cut",
+    "Search",
+    "Sync",
+    "Setting",  // Settings
+    "Update",
+    "Return",
+    "Connect",
+    "History",
+    "Filter",
+    "Scroll",
+    "IOT",
+    "Tag",
+    "VPN",
+    "Hide",
+    "Unit",
+    "View",
+    // Media
+    "Play",
+    "Pause",
+    "Volume",
+    "Mute",
+    "SkipBack",
+    "SkipForward",
+    "PlaySolid",
+    "SpeedOff",
+    "SpeedHigh",
+    "SpeedMedium",
+    // UI
+    "Menu",
+    "More",
+    "Close",
+    "BackToWindow",
+    "FullScreen",
+    "Minimize",
+    "Home",
+    "Info",
+    "Layout",
+    "Alignment",
+    "PageLeft",
+    "PageRight",
+    // Common
+    "Folder",
+    "Document",  // File
+    "Download",
+    "Link",
+    "Share",
+    "Print",
+    "Mail",
+    "Message",
+    "Calendar",
+    "DateTime",  // Clock
+    "DateTime",
+    "Document",
+    "Language",
+    "Question",
+    "Speakers",
+    "FontSize",
+    // Misc
+    "Setting",
+    "Help",
+    "GitHub",  // Github
+    "QRCode",  // QrCode
+    "Wifi",
+    "Bluetooth",
+    "Airplane",
+    "Train",
+    "Car",
+    "Bus",
+    "Cafe",
+    "Chat",
+    "Code",
+    "Game",
+    "Flag",
+    "Font",
+    "Leaf",
+    "Movie",
+    "Music",
+    "Robot",
+    "Photo",
+    "Phone",
+    "Ringer",
+    "Rotate",
+    "Zoom",
+    "ZoomIn",
+    "ZoomOut",
+    "Album",
+    "Brush",
+    "Broom",
+    "Cloud",
+    "Embed",
+    "Globe",
+    "Heart",
+    "Label",
+    "Media",
+    "PauseBold",
+    "PencilInk",
+    "Tiles",
+    "Unpin",
+    "Video",
+    "AddTo",
+    "Camera",
+    "Market",
+    "People",
+    "Frigid",
+    "SaveAs",
+    "Palette",
+    "FitPage",
+    "Basketball",  // BasketBall
+    "Brightness",
+    "Dictionary",
+    "Microphone",
+    "Headphone",
+    "Megaphone",
+    "Projector",
+    "Education",
+    "EraseTool",
+    "BookShelf",
+    "Highlight",
+    "FolderAdd",
+    "PieSingle",
+    "QuickNote",
+    "Stopwatch",  // StopWatch
+    "ZipFolder",
+    "Application",
+    "Certificate",
+    "Transparent",
+    "ImageExport",
+    "LibraryFill",
+    "MusicFolder",
+    "PowerButton",
+    "AcceptMedium",
+    "CancelMedium",
+    "ChevronDownMed",
+    "ChevronRightMed",
+    "EmojiTabSymbols",
+    "ExpressiveInputEntry",
+    "ClippingTool",
+    "SearchMirror",
+    "ShoppingCart",
+    "FontIncrease",
+    "CommandPrompt",
+    "CloudDownload",
+    "DictionaryAdd",
+    "ClearSelection",
+    "DeveloperTools",
+    "BackgroundColor",
+    "MixVolumes",
+    "RemoveFrom",
+    "QuietHours",
+    "Fingerprint",
+    "CheckBox",
+    "HomeFill",
+    "SaveCopy",
+    "SendFill",
+    "Feedback",
+    "Asterisk",
+    "Calories",
+    "Constract",
+    "Move",
+    "Send",
+    "Pin",
+    // Extend
+    "ArrowUndo",
+    "ArrowRedo",
+    "ArrowClockwise",
+    "ArrowUpload",
+    "LockClosed",
+    "LockOpen",
+    "BookmarkSingle",
+    "Star",
+    "StarFilled",
+    "Person",
+    "Warning",
+    "DismissCircle",
+    "CheckMark",
+    "QuestionCircle",
+    "TextBold",
+    "TextItalic",
+    "TextUnderline",
+    "TextStrikethrough",
+    "TextAlignLeft",
+    "TextAlignCenter",
+    "TextAlignRight",
+    "TextAlignJustify",
+    "TextBulletList",
+    "TextNumberListRTL",
+    "TextIndentIncrease",
+    "TextIndentDecrease",
+    "TextQuote",
+    "LinkDismiss",
+    "Table",
+    "Image",
+    "FolderOpen",
+    "Cart",
+    "Circle",
+    "Crop",
+    "Drop",
+};
+
+static constexpr int kFluentIconCount =
+    static_cast<int>(sizeof(kFluentIconNames) / sizeof(kFluentIconNames[0]));
+static_assert(kFluentIconCount == static_cast<int>(FluentIconEnum::Drop) + 1,
+              "kFluentIconNames must list every FluentIconEnum value in order");
+
+struct FluentIconTable {
+    QString names[kFluentIconCount];
+    QString paths[kFluentIconCount][2];  // [icon][0: black, 1: white]
+};
+
+// Built and validated once; icons without a resource fall back to the Info glyph.
+static const FluentIconTable& fluentIconTable() {
+    static const FluentIconTable table = [] {
+        FluentIconTable t;
+        const QString prefix = QStringLiteral(":/qfluentwidgets/images/icons/");
+        const QString suffixes[2] = {QStringLiteral("_black.svg"), QStringLiteral("_white.svg")};
+        for (int i = 0; i < kFluentIconCount; ++i) {
+            t.names[i] = QString::fromLatin1(kFluentIconNames[i]);
+            for (int variant = 0; variant < 2; ++variant) {
+                QString path = prefix + t.names[i] + suffixes[variant];
+                if (!QFile::exists(path)) {
+                    qWarning("[qfw] missing icon resource %s", qPrintable(path));
+                    path = prefix + QStringLiteral("Info") + suffixes[variant];
+                }
+                t.paths[i][variant] = path;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+
+static bool isWhiteIconVariant(Theme theme, bool reverse) {
+    const bool dark = (theme == Theme::Auto) ? isDarkTheme() : (theme == Theme::Dark);
+    return dark != reverse;
+}
 
-QString FluentIcon::path(Theme theme) const {
-    QString color = getIconColor(theme, false);
-    QString iconName = enumToString(icon_);
-    return QStringLiteral(":/qfluentwidgets/images/icons/%1_%2.svg").arg(iconName, color);
+static const QString& fluentIconPath(FluentIconEnum icon, Theme theme, bool reverse) {
+    const int index = qBound(0, static_cast<int>(icon), kFluentIconCount - 1);
+    return fluentIconTable().paths[index][isWhiteIconVariant(theme, reverse) ? 1 : 0];
 }
 
+FluentIcon::FluentIcon(FluentIconEnum icon) : icon_(icon) {}
+
+QString FluentIcon::path(Theme theme) const { return fluentIconPath(icon_, theme, false); }
+
 QIcon FluentIcon::icon(Theme theme, const QColor& color) const {
     const QString iconPath = path(theme);
     if (iconPath.endsWith(QStringLiteral(".svg")) && color.isValid()) {
-        QVariantMap attributes;
-        attributes.insert(QStringLiteral("fill"), color.name());
-        attributes.insert(QStringLiteral("stroke"), color.name());
-        const QString svg = writeSvg(iconPath, QList<int>(), attributes);
-        if (!svg.isEmpty()) {
-            return QIcon(new SvgIconEngine(svg.toUtf8()));
-        }
-
-        return QIcon(new SvgIconEngine(iconPath));
+        return recoloredSvgIcon(iconPath, color, color);
     }
 
     return QIcon(iconPath);
@@ -479,502 +1212,33 @@ QIcon FluentIcon::icon(Theme theme, const QColor& color) const {
 
 void FluentIcon::render(QPainter* painter, const QRect& rect, Theme theme,
                         const QVariantMap& attributes) const {
-    const bool reverse = attributes.value(QStringLiteral("reverse")).toBool();
-    const QString color = getIconColor(theme, reverse);
-    const QString iconName = enumToString(icon_);
-    QString iconPath =
-        QStringLiteral(":/qfluentwidgets/images/icons/%1_%2.svg").arg(iconName, color);
-
-    if (!QFile::exists(iconPath)) {
-        iconPath = QStringLiteral(":/qfluentwidgets/images/icons/Info_%1.svg").arg(color);
+    IconRenderOptions options;
+    if (toRenderOptions(attributes, &options)) {
+        render(painter, rect, theme, options);
+        return;
     }
 
-    if (attributes.contains(QStringLiteral("fill")) ||
-        attributes.contains(QStringLiteral("stroke"))) {
-        // Apply attributes (like fill color) to SVG before drawing
-        QString svg = writeSvg(iconPath, QList<int>(), attributes);
-        if (!svg.isEmpty()) {
-            drawSvgIcon(svg.toUtf8(), painter, rect);
-            return;
-        }
-    }
+    // Apply attributes (like fill color) to SVG before drawing
+    const bool reverse = attributes.value(QStringLiteral("reverse")).toBool();
+    const bool recolor = attributes.contains(QStringLiteral("fill")) ||
+                         attributes.contains(QStringLiteral("stroke"));
+    drawCachedSvgIcon(painter, rect, fluentIconPath(icon_, theme, reverse), IconRenderOptions(),
+                      recolor ? attributes : QVariantMap());
+}
 
-    drawSvgIcon(iconPath, painter, rect);
+void FluentIcon::render(QPainter* painter, const QRect& rect, Theme theme,
+                        const IconRenderOptions& options) const {
+    drawCachedSvgIcon(painter, rect, fluentIconPath(icon_, theme, options.reverse), options);
 }
 
 FluentIconBase* FluentIcon::clone() const { return new FluentIcon(*this); }
 
 QString FluentIcon::enumToString(FluentIconEnum icon) {
-    switch (icon) {
-        // Navigation
-        case FluentIconEnum::Up:
-            return QStringLiteral("Up");
-        case FluentIconEnum::Down:
-            return QStringLiteral("Down");
-        case FluentIconEnum::ChevronDown:
-            return QStringLiteral("ChevronDown");
-        case FluentIconEnum::ChevronRight:
-            return QStringLiteral("ChevronRight");
-        case FluentIconEnum::ChevronDownMed:
-            return QStringLiteral("ChevronDownMed");
-        case FluentIconEnum::ChevronRightMed:
-            return QStringLiteral("ChevronRightMed");
-        case FluentIconEnum::CareUpSolid:
-            return QStringLiteral("CareUpSolid");
-        case FluentIconEnum::CareDownSolid:
-            return QStringLiteral("CareDownSolid");
-        case FluentIconEnum::CareLeftSolid:
-            return QStringLiteral("CareLeftSolid");
-        case FluentIconEnum::CareRightSolid:
-            return QStringLiteral("CareRightSolid");
-        case FluentIconEnum::LeftArrow:
-            return QStringLiteral("LeftArrow");
-        case FluentIconEnum::RightArrow:
-            return QStringLiteral("RightArrow");
-        case FluentIconEnum::ArrowDown:
-            return QStringLiteral("ChevronDown");
-
-        // Actions
-        case FluentIconEnum::Add:
-            return QStringLiteral("Add");
-        case FluentIconEnum::Remove:
-            return QStringLiteral("Remove");
-        case FluentIconEnum::Delete:
-            return QStringLiteral("Delete");
-        case FluentIconEnum::Edit:
-            return QStringLiteral("Edit");
-        case FluentIconEnum::Save:
-            return QStringLiteral("Save");
-        case FluentIconEnum::Cancel:
-            return QStringLiteral("Cancel");
-        case FluentIconEnum::Accept:
-            return QStringLiteral("Accept");
-        case FluentIconEnum::AcceptMedium:
-            return QStringLiteral("AcceptMedium");
-        case FluentIconEnum::CancelMedium:
-            return QStringLiteral("CancelMedium");
-        case FluentIconEnum::Copy:
-            return QStringLiteral("Copy");
-        case FluentIconEnum::Paste:
-            return QStringLiteral("Paste");
-        case FluentIconEnum::Cut:
-            return QStringLiteral("Cut");
-        case FluentIconEnum::Search:
-            return QStringLiteral("Search");
-        case FluentIconEnum::Sync:
-            return QStringLiteral("Sync");
-        case FluentIconEnum::Settings:
-            return QStringLiteral("Setting");
-        case FluentIconEnum::Update:
-            return QStringLiteral("Update");
-        case FluentIconEnum::Return:
-            return QStringLiteral("Return");
-        case FluentIconEnum::Connect:
-            return QStringLiteral("Connect");
-        case FluentIconEnum::History:
-            return QStringLiteral("History");
-        case FluentIconEnum::Filter:
-            return QStringLiteral("Filter");
-        case FluentIconEnum::Scroll:
-            return QStringLiteral("Scroll");
-
-        // Media
-        case FluentIconEnum::Play:
-            return QStringLiteral("Play");
-        case FluentIconEnum::Pause:
-            return QStringLiteral("Pause");
-        case FluentIconEnum::Volume:
-            return QStringLiteral("Volume");
-        case FluentIconEnum::Mute:
-            return QStringLiteral("Mute");
-        case FluentIconEnum::SkipBack:
-            return QStringLiteral("SkipBack");
-        case FluentIconEnum::SkipForward:
-            return QStringLiteral("SkipForward");
-        case FluentIconEnum::PlaySolid:
-            return QStringLiteral("PlaySolid");
-        case FluentIconEnum::SpeedOff:
-            return QStringLiteral("SpeedOff");
-        case FluentIconEnum::SpeedHigh:
-            return QStringLiteral("SpeedHigh");
-        case FluentIconEnum::SpeedMedium:
-            return QStringLiteral("SpeedMedium");
-
-        // UI
-        case FluentIconEnum::Menu:
-            return QStringLiteral("Menu");
-        case FluentIconEnum::More:
-            return QStringLiteral("More");
-        case FluentIconEnum::Close:
-            return QStringLiteral("Close");
-        case FluentIconEnum::BackToWindow:
-            return QStringLiteral("BackToWindow");
-        case FluentIconEnum::FullScreen:
-            return QStringLiteral("FullScreen");
-        case FluentIconEnum::Minimize:
-            return QStringLiteral("Minimize");
-        case FluentIconEnum::Home:
-            return QStringLiteral("Home");
-        case FluentIconEnum::Info:
-            return QStringLiteral("Info");
-        case FluentIconEnum::Layout:
-            return QStringLiteral("Layout");
-        case FluentIconEnum::Alignment:
-            return QStringLiteral("Alignment");
-        case FluentIconEnum::PageLeft:
-            return QStringLiteral("PageLeft");
-        case FluentIconEnum::PageRight:
-            return QStringLiteral("PageRight");
-
-        // Common
-        case FluentIconEnum::Folder:
-            return QStringLiteral("Folder");
-        case FluentIconEnum::File:
-            return QStringLiteral("Document");
-        case FluentIconEnum::Download:
-            return QStringLiteral("Download");
-        case FluentIconEnum::Link:
-            return QStringLiteral("Link");
-        case FluentIconEnum::Share:
-            return QStringLiteral("Share");
-        case FluentIconEnum::Print:
-            return QStringLiteral("Print");
-        case FluentIconEnum::Mail:
-            return QStringLiteral("Mail");
-        case FluentIconEnum::Message:
-            return QStringLiteral("Message");
-        case FluentIconEnum::Calendar:
-            return QStringLiteral("Calendar");
-        case FluentIconEnum::Clock:
-            return QStringLiteral("DateTime");
-        case FluentIconEnum::DateTime:
-            return QStringLiteral("DateTime");
-        case FluentIconEnum::Document:
-            return QStringLiteral("Document");
-        case FluentIconEnum::Language:
-            return QStringLiteral("Language");
-        case FluentIconEnum::Question:
-            return QStringLiteral("Question");
-        case FluentIconEnum::Speakers:
-            return QStringLiteral("Speakers");
-        case FluentIconEnum::FontSize:
-            return QStringLiteral("FontSize");
-
-        // Misc
-        case FluentIconEnum::Setting:
-            return QStringLiteral("Setting");
-        case FluentIconEnum::Help:
-            return QStringLiteral("Help");
-        case FluentIconEnum::Github:
-            return QStringLiteral("GitHub");
-        case FluentIconEnum::QrCode:
-            return QStringLiteral("QRCode");
-        case FluentIconEnum::Wifi:
-            return QStringLiteral("Wifi");
-        case FluentIconEnum::Bluetooth:
-            return QStringLiteral("Bluetooth");
-        case FluentIconEnum::Airplane:
-            return QStringLiteral("Airplane");
-        case FluentIconEnum::Train:
-            return QStringLiteral("Train");
-        case FluentIconEnum::Car:
-            return QStringLiteral("Car");
-        case FluentIconEnum::Bus:
-            return QStringLiteral("Bus");
-        case FluentIconEnum::Cafe:
-            return QStringLiteral("Cafe");
-        case FluentIconEnum::Chat:
-            return QStringLiteral("Chat");
-        case FluentIconEnum::Code:
-            return QStringLiteral("Code");
-        case FluentIconEnum::Game:
-            return QStringLiteral("Game");
-        case FluentIconEnum::Flag:
-            return QStringLiteral("Flag");
-        case FluentIconEnum::Font:
-            return QStringLiteral("Font");
-        case FluentIconEnum::Leaf:
-            return QStringLiteral("Leaf");
-        case FluentIconEnum::Movie:
-            return QStringLiteral("Movie");
-        case FluentIconEnum::Music:
-            return QStringLiteral("Music");
-        case FluentIconEnum::Robot:
-            return QStringLiteral("Robot");
-        case FluentIconEnum::Photo:
-            return QStringLiteral("Photo");
-        case FluentIconEnum::Phone:
-            return QStringLiteral("Phone");
-        case FluentIconEnum::Ringer:
-            return QStringLiteral("Ringer");
-        case FluentIconEnum::Rotate:
-            return QStringLiteral("Rotate");
-        case FluentIconEnum::Zoom:
-            return QStringLiteral("Zoom");
-        case FluentIconEnum::ZoomIn:
-            return QStringLiteral("ZoomIn");
-        case FluentIconEnum::ZoomOut:
-            return QStringLiteral("ZoomOut");
-        case FluentIconEnum::Album:
-            return QStringLiteral("Album");
-        case FluentIconEnum::Brush:
-            return QStringLiteral("Brush");
-        case FluentIconEnum::Broom:
-            return QStringLiteral("Broom");
-        case FluentIconEnum::Cloud:
-            return QStringLiteral("Cloud");
-        case FluentIconEnum::Embed:
-            return QStringLiteral("Embed");
-        case FluentIconEnum::Globe:
-            return QStringLiteral("Globe");
-        case FluentIconEnum::Heart:
-            return QStringLiteral("Heart");
-        case FluentIconEnum::Label:
-            return QStringLiteral("Label");
-        case FluentIconEnum::Media:
-            return QStringLiteral("Media");
-        case FluentIconEnum::PauseBold:
-            return QStringLiteral("PauseBold");
-        case FluentIconEnum::PencilInk:
-            return QStringLiteral("PencilInk");
-        case FluentIconEnum::Tiles:
-            return QStringLiteral("Tiles");
-        case FluentIconEnum::Unpin:
-            return QStringLiteral("Unpin");
-        case FluentIconEnum::Video:
-            return QStringLiteral("Video");
-        case FluentIconEnum::AddTo:
-            return QStringLiteral("AddTo");
-        case FluentIconEnum::Camera:
-            return QStringLiteral("Camera");
-        case FluentIconEnum::Market:
-            return QStringLiteral("Market");
-        case FluentIconEnum::People:
-            return QStringLiteral("People");
-        case FluentIconEnum::Frigid:
-            return QStringLiteral("Frigid");
-        case FluentIconEnum::SaveAs:
-            return QStringLiteral("SaveAs");
-        case FluentIconEnum::FitPage:
-            return QStringLiteral("FitPage");
-        case FluentIconEnum::BasketBall:
-            return QStringLiteral("Basketball");
-        case FluentIconEnum::Brightness:
-            return QStringLiteral("Brightness");
-        case FluentIconEnum::Dictionary:
-            return QStringLiteral("Dictionary");
-        case FluentIconEnum::Microphone:
-            return QStringLiteral("Microphone");
-        case FluentIconEnum::Headphone:
-            return QStringLiteral("Headphone");
-        case FluentIconEnum::Megaphone:
-            return QStringLiteral("Megaphone");
-        case FluentIconEnum::Projector:
-            return QStringLiteral("Projector");
-        case FluentIconEnum::Education:
-            return QStringLiteral("Education");
-        case FluentIconEnum::EraseTool:
-            return QStringLiteral("EraseTool");
-        case FluentIconEnum::BookShelf:
-            return QStringLiteral("BookShelf");
-        case FluentIconEnum::Highlight:
-            return QStringLiteral("Highlight");
-        case FluentIconEnum::PieSingle:
-            return QStringLiteral("PieSingle");
-        case FluentIconEnum::QuickNote:
-            return QStringLiteral("QuickNote");
-        case FluentIconEnum::StopWatch:
-            return QStringLiteral("StopWatch");
-        case FluentIconEnum::ZipFolder:
-            return QStringLiteral("ZipFolder");
-        case FluentIconEnum::Application:
-            return QStringLiteral("Application");
-        case FluentIconEnum::Certificate:
-            return QStringLiteral("Certificate");
-        case FluentIconEnum::ImageExport:
-            return QStringLiteral("ImageExport");
-        case FluentIconEnum::LibraryFill:
-            return QStringLiteral("LibraryFill");
-        case FluentIconEnum::MusicFolder:
-            return QStringLiteral("MusicFolder");
-        case FluentIconEnum::PowerButton:
-            return QStringLiteral("PowerButton");
-        case FluentIconEnum::EmojiTabSymbols:
-            return QStringLiteral("EmojiTabSymbols");
-        case FluentIconEnum::ExpressiveInputEntry:
-            return QStringLiteral("ExpressiveInputEntry");
-        case FluentIconEnum::ClippingTool:
-            return QStringLiteral("ClippingTool");
-        case FluentIconEnum::ClearSelection:
-            return QStringLiteral("ClearSelection");
-        case FluentIconEnum::DeveloperTools:
-            return QStringLiteral("DeveloperTools");
-        case FluentIconEnum::BackgroundColor:
-            return QStringLiteral("BackgroundColor");
-        case FluentIconEnum::MixVolumes:
-            return QStringLiteral("MixVolumes");
-        case FluentIconEnum::RemoveFrom:
-            return QStringLiteral("RemoveFrom");
-        case FluentIconEnum::QuietHours:
-            return QStringLiteral("QuietHours");
-        case FluentIconEnum::Fingerprint:
-            return QStringLiteral("Fingerprint");
-        case FluentIconEnum::CheckBox:
-            return QStringLiteral("CheckBox");
-        case FluentIconEnum::HomeFill:
-            return QStringLiteral("HomeFill");
-        case FluentIconEnum::SearchMirror:
-            return QStringLiteral("SearchMirror");
-        case FluentIconEnum::ShoppingCart:
-            return QStringLiteral("ShoppingCart");
-        case FluentIconEnum::FontIncrease:
-            return QStringLiteral("FontIncrease");
-        case FluentIconEnum::CommandPrompt:
-            return QStringLiteral("CommandPrompt");
-        case FluentIconEnum::CloudDownload:
-            return QStringLiteral("CloudDownload");
-        case FluentIconEnum::DictionaryAdd:
-            return QStringLiteral("DictionaryAdd");
-        case FluentIconEnum::SaveCopy:
-            return QStringLiteral("SaveCopy");
-        case FluentIconEnum::SendFill:
-            return QStringLiteral("SendFill");
-        case FluentIconEnum::Transparent:
-            return QStringLiteral("Transparent");
-        case FluentIconEnum::Palette:
-            return QStringLiteral("Palette");
-        case FluentIconEnum::Feedback:
-            return QStringLiteral("Feedback");
-        case FluentIconEnum::FolderAdd:
-            return QStringLiteral("FolderAdd");
-        case FluentIconEnum::Asterisk:
-            return QStringLiteral("Asterisk");
-        case FluentIconEnum::Calories:
-            return QStringLiteral("Calories");
-        case FluentIconEnum::Constract:
-            return QStringLiteral("Constract");
-        case FluentIconEnum::IOT:
-            return QStringLiteral("IOT");
-        case FluentIconEnum::Move:
-            return QStringLiteral("Move");
-        case FluentIconEnum::Pin:
-            return QStringLiteral("Pin");
-        case FluentIconEnum::Tag:
-            return QStringLiteral("Tag");
-        case FluentIconEnum::VPN:
-            return QStringLiteral("VPN");
-        case FluentIconEnum::Hide:
-            return QStringLiteral("Hide");
-        case FluentIconEnum::View:
-            return QStringLiteral("View");
-
-            // Extend
-        case FluentIconEnum::ArrowUndo:
-            return QStringLiteral("ArrowUndo");
-        case FluentIconEnum::ArrowRedo:
-            return QStringLiteral("ArrowRedo");
-        case FluentIconEnum::ArrowClockwise:
-            return QStringLiteral("ArrowClockwise");
-
-        case FluentIconEnum::ArrowUpload:
-            return QStringLiteral("ArrowUpload");
-
-        case FluentIconEnum::LockClosed:
-            return QStringLiteral("LockClosed");
-
-        case FluentIconEnum::LockOpen:
-            return QStringLiteral("LockOpen");
-
-        case FluentIconEnum::BookmarkSingle:
-            return QStringLiteral("BookmarkSingle");
-
-        case FluentIconEnum::Star:
-            return QStringLiteral("Star");
-
-        case FluentIconEnum::StarFilled:
-            return QStringLiteral("StarFilled");
-
-        case FluentIconEnum::Person:
-            return QStringLiteral("Person");
-
-        case FluentIconEnum::Warning:
-            return QStringLiteral("Warning");
-
-        case FluentIconEnum::DismissCircle:
-            return QStringLiteral("DismissCircle");
-
-        case FluentIconEnum::CheckMark:
-            return QStringLiteral("CheckMark");
-
-        case FluentIconEnum::QuestionCircle:
-            return QStringLiteral("QuestionCircle");
-
-        case FluentIconEnum::TextBold:
-            return QStringLiteral("TextBold");
-
-        case FluentIconEnum::TextItalic:
-            return QStringLiteral("TextItalic");
-
-        case FluentIconEnum::TextUnderline:
-            return QStringLiteral("TextUnderline");
-
-        case FluentIconEnum::TextStrikethrough:
-            return QStringLiteral("TextStrikethrough");
-
-        case FluentIconEnum::TextAlignLeft:
-            return QStringLiteral("TextAlignLeft");
-
-        case FluentIconEnum::TextAlignCenter:
-            return QStringLiteral("TextAlignCenter");
-
-        case FluentIconEnum::TextAlignRight:
-            return QStringLiteral("TextAlignRight");
-
-        case FluentIconEnum::TextAlignJustify:
-            return QStringLiteral("TextAlignJustify");
-
-        case FluentIconEnum::TextBulletList:
-            return QStringLiteral("TextBulletList");
-
-        case FluentIconEnum::TextNumberListRTL:
-            return QStringLiteral("TextNumberListRTL");
-
-        case FluentIconEnum::TextIndentIncrease:
-            return QStringLiteral("TextIndentIncrease");
-
-        case FluentIconEnum::TextIndentDecrease:
-            return QStringLiteral("TextIndentDecrease");
-
-        case FluentIconEnum::TextQuote:
-            return QStringLiteral("TextQuote");
-
-        case FluentIconEnum::LinkDismiss:
-            return QStringLiteral("LinkDismiss");
-
-        case FluentIconEnum::Table:
-            return QStringLiteral("Table");
-
-        case FluentIconEnum::Image:
-            return QStringLiteral("Image");
-
-        case FluentIconEnum::FolderOpen:
-            return QStringLiteral("FolderOpen");
-
-        case FluentIconEnum::Cart:
-            return QStringLiteral("Cart");
-
-        case FluentIconEnum::Circle:
-            return QStringLiteral("Circle");
-
-        case FluentIconEnum::Crop:
-            return QStringLiteral("Crop");
-
-        case FluentIconEnum::Drop:
-            return QStringLiteral("Drop");
-
-        default:
-            return QStringLiteral("Unknown");
+    const int index = static_cast<int>(icon);
+    if (index < 0 || index >= kFluentIconCount) {
+        return QStringLiteral("Unknown");
     }
+    return fluentIconTable().names[index];
 }
 
 }  // namespace qfw
@@ -2,13 +2,18 @@
 
 #include <QAction>
 #include <QColor>
+#include <QHash>
 #include <QIcon>
 #include <QIconEngine>
 #include <QPainter>
+#include <QSharedPointer>
 #include <QString>
+#include <QVector>
 
 #include "common/config.h"
 
+class QSvgRenderer;
+
 namespace qfw {
 
 // Forward declarations
@@ -23,16 +28,21 @@ class FluentIconEngine : public QIconEngine {
 public:
     FluentIconEngine(const FluentIconBase* icon, bool reverse = false);
     FluentIconEngine(const FluentIconBase& icon, bool reverse = false);
-    ~FluentIconEngine() override;
 
     void paint(QPainter* painter, const QRect& rect, QIcon::Mode mode, QIcon::State state) override;
     QIconEngine* clone() const override;
     QPixmap pixmap(const QSize& size, QIcon::Mode mode, QIcon::State state) override;
 
 private:
-    const FluentIconBase* icon_;
+    FluentIconEngine(const QSharedPointer<const FluentIconBase>& icon, bool reverse);
+
+    // Immutable once constructed, so clones share it instead of deep-copying
+    QSharedPointer<const FluentIconBase> icon_;
     bool isThemeReversed_;
-    bool ownsIcon_;
+
+    // pixmap() results, dropped when the theme or theme color changes
+    QHash<quint64, QPixmap> pixmaps_;
+    quint64 pixmapThemeKey_ = 0;
 };
 
 class SvgIconEngine : public QIconEngine {
@@ -46,6 +56,7 @@ public:
 
 private:
     QByteArray svgData_;
+    QSharedPointer<QSvgRenderer> renderer_;  // parsed on first paint, shared with clones
 };
 
 class FontIconEngine : public QIconEngine {
@@ -68,6 +79,16 @@ private:
 // Helper Functions
 // ============================================================================
 
+struct FontIconGlyph {
+    QRect rect;
+    QString character;
+};
+
+// Draws many font icons sharing a family, weight and color as one glyph run per pixel size,
+// e.g. for delegates painting an icon on every visible row.
+void drawFontIcons(QPainter* painter, const QString& fontFamily, const QColor& color, bool bold,
+                   const QVector<FontIconGlyph>& glyphs);
+
 void drawSvgIcon(const QString& iconPath, QPainter* painter, const QRect& rect);
 void drawSvgIcon(const QByteArray& iconData, QPainter* painter, const QRect& rect);
 
@@ -83,6 +104,13 @@ QIcon toQIcon(const QString& iconPath);
 // Fluent Icon Base Classes
 // ============================================================================
 
+// Typed counterpart of the attribute map taken by FluentIconBase::render.
+struct IconRenderOptions {
+    bool reverse = false;  // draw the variant of the opposite theme
+    QColor fill;           // overrides the fill of every path when valid
+    QColor stroke;         // overrides the stroke of every path when valid
+};
+
 class FluentIconBase {
 public:
     virtual ~FluentIconBase() = default;
@@ -100,6 +128,11 @@ public:
     virtual void render(QPainter* painter, const QRect& rect, Theme theme = Theme::Auto,
                         const QVariantMap& attributes = {}) const;
 
+    // Same without building an attribute map; used on paint paths. The default forwards to
+    // the QVariantMap overload so subclasses that only override that one keep working.
+    virtual void render(QPainter* painter, const QRect& rect, Theme theme,
+                        const IconRenderOptions& options) const;
+
     // Create colored version
     ColoredFluentIcon* colored(const QColor& lightColor, const QColor& darkColor) const;
 
@@ -137,6 +170,8 @@ public:
     QIcon icon(Theme theme = Theme::Auto, const QColor& color = QColor()) const override;
     void render(QPainter* painter, const QRect& rect, Theme theme = Theme::Auto,
                 const QVariantMap& attributes = {}) const override;
+    void render(QPainter* painter, const QRect& rect, Theme theme,
+                const IconRenderOptions& options) const override;
     FluentIconBase* clone() const override;
 
 private:
@@ -409,6 +444,8 @@ public:
     QIcon icon(Theme theme = Theme::Auto, const QColor& color = QColor()) const override;
     void render(QPainter* painter, const QRect& rect, Theme theme = Theme::Auto,
                 const QVariantMap& attributes = {}) const override;
+    void render(QPainter* painter, const QRect& rect, Theme theme,
+                const IconRenderOptions& options) const override;
     FluentIconBase* clone() const override;
 
     static QString enumToString(FluentIconEnum icon);
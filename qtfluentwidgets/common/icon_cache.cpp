@@ -0,0 +1,275 @@
+#include "common/icon_cache.h"
+
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QHash>
+#include <QImage>
+#include <QPaintDevice>
+#include <QPainter>
+#include <QScopedPointer>
+#include <QThreadPool>
+#include <QVector>
+#include <QtSvg/QSvgRenderer>
+
+#include "common/config.h"
+
+namespace qfw {
+
+bool FluentIconCache::Key::operator==(const Key& other) const {
+    return mode == other.mode && size == other.size &&
+           qFuzzyCompare(devicePixelRatio, other.devicePixelRatio) && fill == other.fill &&
+           stroke == other.stroke && source == other.source && attributes == other.attributes;
+}
+
+qHash_result_type qHash(const FluentIconCache::Key& key, qHash_result_type seed) {
+    seed ^= qHash(key.source, seed);
+    seed ^= qHash(key.attributes, seed) * 31;
+    seed ^= qHash(key.fill.rgba(), seed) ^ (qHash(key.stroke.rgba(), seed) << 1);
+    seed ^= static_cast<qHash_result_type>(key.size.width() * 7919 + key.size.height());
+    seed ^= static_cast<qHash_result_type>(qRound(key.devicePixelRatio * 100) << 8);
+    seed ^= static_cast<qHash_result_type>(key.mode) << 24;
+    return seed;
+}
+
+FluentIconCache::FluentIconCache() { cache_.setMaxCost(DefaultMaxBytes); }
+
+FluentIconCache& FluentIconCache::instance() {
+    static FluentIconCache cache;
+    return cache;
+}
+
+bool FluentIconCache::canCache(const QPainter* painter) {
+    const QPaintDevice* device = painter->device();
+    if (!device || device->devType() == QInternal::Printer ||
+        device->devType() == QInternal::Picture) {
+        return false;
+    }
+
+    // Scaled or rotated painters would resample the cached raster; draw those as vectors.
+    return painter->worldTransform().type() <= QTransform::TxTranslate;
+}
+
+bool FluentIconCache::find(const Key& key, QPixmap* pixmap) {
+    const QPixmap* cached = cache_.object(key);
+    if (!cached) {
+        return false;
+    }
+
+    *pixmap = *cached;
+    return true;
+}
+
+void FluentIconCache::insert(const Key& key, const QPixmap& pixmap) {
+    const int cost = pixmap.width() * pixmap.height() * pixmap.depth() / 8;
+    cache_.insert(key, new QPixmap(pixmap), cost);
+}
+
+void FluentIconCache::clear() { cache_.clear(); }
+
+static constexpr int kPrewarmBatchSize = 16;
+
+void FluentIconCache::prewarm(const QList<FluentIconEnum>& icons, const QList<QSize>& sizes,
+                              const QList<Theme>& themes, qreal devicePixelRatio) {
+    if (devicePixelRatio <= 0) {
+        devicePixelRatio = qGuiApp ? qGuiApp->devicePixelRatio() : 1.0;
+    }
+
+    QVector<Key> pending;
+    for (FluentIconEnum icon : icons) {
+        for (Theme theme : themes) {
+            const QString path = FluentIcon(icon).path(theme);
+            for (const QSize& size : sizes) {
+                Key key;
+                key.source = path;
+                key.size = size;
+                key.devicePixelRatio = devicePixelRatio;
+                if (!size.isEmpty() && !cache_.contains(key)) {
+                    pending.append(key);
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < pending.size(); i += kPrewarmBatchSize) {
+        const QVector<Key> batch = pending.mid(i, kPrewarmBatchSize);
+        QThreadPool::globalInstance()->start([batch]() {
+            // QSvgRenderer painting onto a QImage is safe off the GUI thread; QPixmap is not
+            QVector<QImage> images;
+            images.reserve(batch.size());
+            QScopedPointer<QSvgRenderer> renderer;
+            QString rendererPath;
+            for (const Key& key : batch) {
+                if (!renderer || rendererPath != key.source) {
+                    renderer.reset(new QSvgRenderer(key.source));
+                    rendererPath = key.source;
+                }
+
+                QImage image;
+                if (renderer->isValid()) {
+                    image = QImage((QSizeF(key.size) * key.devicePixelRatio).toSize(),
+                                   QImage::Format_ARGB32_Premultiplied);
+                    image.fill(Qt::transparent);
+
+                    QPainter painter(&image);
+                    painter.setRenderHints(QPainter::Antialiasing |
+                                           QPainter::SmoothPixmapTransform);
+                    renderer->render(&painter, QRectF(image.rect()));
+                }
+                images.append(image);
+            }
+
+            QCoreApplication* app = QCoreApplication::instance();
+            if (!app) {
+                return;
+            }
+            QMetaObject::invokeMethod(
+                app,
+                [batch, images]() {
+                    FluentIconCache& cache = FluentIconCache::instance();
+                    for (int j = 0; j < batch.size(); ++j) {
+                        if (images.at(j).isNull()) {
+                            continue;
+                        }
+
+                        QPixmap pixmap = QPixmap::fromImage(images.at(j), Qt::NoFormatConversion);
+                        pixmap.setDevicePixelRatio(batch.at(j).devicePixelRatio);
+                        cache.insert(batch.at(j), pixmap);
+                    }
+                },
+                Qt::QueuedConnection);
+        });
+    }
+}
+
+void FluentIconCache::setColorizeByComposition(bool enabled) {
+    if (colorizeByComposition_ == enabled) {
+        return;
+    }
+
+    // Tinted and patched renderings may differ slightly, don't mix them
+    colorizeByComposition_ = enabled;
+    cache_.clear();
+}
+
+void FluentIconCache::setMaxBytes(int bytes) { cache_.setMaxCost(qMax(0, bytes)); }
+
+int FluentIconCache::maxBytes() const { return static_cast<int>(cache_.maxCost()); }
+
+int FluentIconCache::totalBytes() const { return static_cast<int>(cache_.totalCost()); }
+
+// ============================================================================
+// IconAtlas
+// ============================================================================
+
+static constexpr int kAtlasColumns = 16;
+static constexpr int kAtlasMaxRows = 64;
+static constexpr int kAtlasMaxSheets = 16;
+static constexpr int kAtlasGutter = 1;  // keeps filtering from bleeding into neighbours
+
+IconAtlas::IconAtlas() {
+    QObject::connect(&QConfig::instance(), &QConfig::themeChanged, &QConfig::instance(),
+                     [this]() { clear(); });
+}
+
+IconAtlas& IconAtlas::instance() {
+    static IconAtlas atlas;
+    return atlas;
+}
+
+void IconAtlas::clear() { sheets_.clear(); }
+
+bool IconAtlas::drawIcon(QPainter* painter, const QRect& rect, FluentIconEnum icon, Theme theme) {
+    return drawIcon(painter, rect, FluentIcon(icon).path(theme));
+}
+
+bool IconAtlas::drawIcon(QPainter* painter, const QRect& rect, const QString& iconPath) {
+    if (rect.isEmpty() || !FluentIconCache::canCache(painter) ||
+        !iconPath.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive)) {
+        return false;
+    }
+
+    const qreal dpr = painter->device()->devicePixelRatioF();
+    const QSize slotSize = (QSizeF(rect.size()) * dpr).toSize();
+    if (slotSize.isEmpty()) {
+        return false;
+    }
+
+    const quint64 sheetKey = (static_cast<quint64>(slotSize.width()) << 40) |
+                             (static_cast<quint64>(slotSize.height()) << 20) |
+                             static_cast<quint64>(qRound(dpr * 100));
+    auto it = sheets_.find(sheetKey);
+    if (it == sheets_.end()) {
+        if (sheets_.size() >= kAtlasMaxSheets) {
+            sheets_.clear();
+        }
+        it = sheets_.insert(sheetKey, Sheet());
+        it->slotSize = slotSize;
+    }
+
+    int slot = -1;
+    if (!ensureSlot(*it, iconPath, rect.size(), dpr, &slot)) {
+        return false;
+    }
+
+    const int cellWidth = slotSize.width() + kAtlasGutter;
+    const int cellHeight = slotSize.height() + kAtlasGutter;
+    const QRect source((slot % kAtlasColumns) * cellWidth, (slot / kAtlasColumns) * cellHeight,
+                       slotSize.width(), slotSize.height());
+    painter->drawPixmap(rect, it->pixmap, source);
+    return true;
+}
+
+bool IconAtlas::ensureSlot(Sheet& sheet, const QString& iconPath, const QSize& size, qreal dpr,
+                           int* slot) {
+    auto found = sheet.slots.constFind(iconPath);
+    if (found != sheet.slots.constEnd()) {
+        *slot = found.value();
+        return true;
+    }
+
+    const int index = static_cast<int>(sheet.slots.size());
+    const int cellWidth = sheet.slotSize.width() + kAtlasGutter;
+    const int cellHeight = sheet.slotSize.height() + kAtlasGutter;
+
+    // Grow by doubling the row count, copying the slots rendered so far
+    if (index >= sheet.rows * kAtlasColumns) {
+        const int rows = sheet.rows == 0 ? 2 : sheet.rows * 2;
+        if (rows > kAtlasMaxRows) {
+            return false;
+        }
+
+        QPixmap grown(kAtlasColumns * cellWidth, rows * cellHeight);
+        grown.fill(Qt::transparent);
+        if (!sheet.pixmap.isNull()) {
+            QPainter painter(&grown);
+            painter.setCompositionMode(QPainter::CompositionMode_Source);
+            painter.drawPixmap(0, 0, sheet.pixmap);
+        }
+        sheet.pixmap = grown;
+        sheet.rows = rows;
+    }
+
+    const QRect target((index % kAtlasColumns) * cellWidth, (index / kAtlasColumns) * cellHeight,
+                       sheet.slotSize.width(), sheet.slotSize.height());
+    QPainter painter(&sheet.pixmap);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+
+    // Prefer a rendering prewarmed off the GUI thread
+    FluentIconCache::Key key;
+    key.source = iconPath;
+    key.size = size;
+    key.devicePixelRatio = dpr;
+    QPixmap prewarmed;
+    if (FluentIconCache::instance().find(key, &prewarmed)) {
+        painter.drawPixmap(target, prewarmed);
+    } else {
+        drawSvgIcon(iconPath, &painter, target);
+    }
+    painter.end();
+
+    sheet.slots.insert(iconPath, index);
+    *slot = index;
+    return true;
+}
+
+}  // namespace qfw
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QCache>
+#include <QColor>
+#include <QHash>
+#include <QIcon>
+#include <QList>
+#include <QPixmap>
+#include <QRect>
+#include <QSize>
+#include <QString>
+
+#include "common/icon.h"
+#include "common/qtcompat.h"
+
+class QPainter;
+
+namespace qfw {
+
+// Process-wide cache of rasterized icons. Keys cover everything that affects the pixels, so a
+// hit is a single drawPixmap; entries are evicted least-recently-used within a byte budget.
+class FluentIconCache {
+public:
+    struct Key {
+        QString source;      // resolved icon path, already encodes the light/dark variant
+        QString attributes;  // serialized svg attribute overrides, empty if none
+        QColor fill;         // typed overrides, see IconRenderOptions
+        QColor stroke;
+        QSize size;          // logical size
+        qreal devicePixelRatio = 1.0;
+        QIcon::Mode mode = QIcon::Normal;
+
+        bool operator==(const Key& other) const;
+    };
+
+    static constexpr int DefaultMaxBytes = 16 * 1024 * 1024;
+
+    static FluentIconCache& instance();
+
+    // Whether drawing a cached raster on |painter| matches drawing the vector: printers,
+    // pictures and scaled or rotated painters are excluded.
+    static bool canCache(const QPainter* painter);
+
+    bool find(const Key& key, QPixmap* pixmap);
+    void insert(const Key& key, const QPixmap& pixmap);
+    void clear();
+
+    // Rasterizes |icons| for every size and theme into QImages on the global QThreadPool and
+    // publishes them to the cache from the GUI thread, so pages full of icons don't parse SVGs
+    // on first paint. A |devicePixelRatio| <= 0 uses the application's.
+    void prewarm(const QList<FluentIconEnum>& icons, const QList<QSize>& sizes,
+                 const QList<Theme>& themes = {Theme::Light, Theme::Dark},
+                 qreal devicePixelRatio = 0);
+
+    // Tint monochrome icons from one cached alpha mask per size instead of rewriting and
+    // parsing the svg for every color. Enabled by default.
+    void setColorizeByComposition(bool enabled);
+    bool colorizeByComposition() const { return colorizeByComposition_; }
+
+    // Shrinking the budget evicts immediately.
+    void setMaxBytes(int bytes);
+    int maxBytes() const;
+    int totalBytes() const;
+
+private:
+    FluentIconCache();
+
+    QCache<Key, QPixmap> cache_;
+    bool colorizeByComposition_ = true;
+};
+
+qHash_result_type qHash(const FluentIconCache::Key& key, qHash_result_type seed = 0);
+
+// Packs plain icon renderings of one size and DPR into a shared sheet, so icons repeated across
+// toolbars, navigation panels and item views are drawn from a source rect of the same pixmap.
+// Slots are rasterized on first use; all sheets are dropped when the theme changes.
+class IconAtlas {
+public:
+    static IconAtlas& instance();
+
+    // Returns false if the icon can't go through the atlas; the caller then draws it itself.
+    bool drawIcon(QPainter* painter, const QRect& rect, const QString& iconPath);
+    bool drawIcon(QPainter* painter, const QRect& rect, FluentIconEnum icon,
+                  Theme theme = Theme::Auto);
+
+    void clear();
+
+private:
+    IconAtlas();
+
+    struct Sheet {
+        QPixmap pixmap;
+        QSize slotSize;  // device pixels, excluding the gutter
+        int rows = 0;
+        QHash<QString, int> slots;
+    };
+
+    bool ensureSlot(Sheet& sheet, const QString& iconPath, const QSize& size, qreal dpr,
+                    int* slot);
+
+    QHash<quint64, Sheet> sheets_;
+};
+
+}  // namespace qfw
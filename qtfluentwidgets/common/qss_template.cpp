@@ -0,0 +1,376 @@
+#include "common/qss_template.h"
+
+#include <QDataStream>
+#include <QStringView>
+
+namespace qfw {
+
+static const std::array<QString, QssTemplate::TokenCount>& tokenNames() {
+    static const std::array<QString, QssTemplate::TokenCount> names = {
+        QStringLiteral("FontFamilies"),     QStringLiteral("ThemeColorPrimary"),
+        QStringLiteral("ThemeColorDark1"),  QStringLiteral("ThemeColorDark2"),
+        QStringLiteral("ThemeColorDark3"),  QStringLiteral("ThemeColorLight1"),
+        QStringLiteral("ThemeColorLight2"), QStringLiteral("ThemeColorLight3"),
+    };
+    return names;
+}
+
+static bool matchesAt(const QString& text, int pos, const QString& word) {
+    if (pos + word.size() > text.size()) {
+        return false;
+    }
+    return QStringView(text.constData() + pos, word.size()) == QStringView(word);
+}
+
+QString QssTemplate::tokenName(Token token) {
+    if (token < 0 || token >= TokenCount) {
+        return {};
+    }
+    return tokenNames()[token];
+}
+
+QssTemplate QssTemplate::compile(const QString& qss) {
+    QssTemplate t;
+    t.source_ = qss;
+
+    const auto& names = tokenNames();
+    const QLatin1String prefix("--");
+
+    int literalStart = 0;
+    int pos = static_cast<int>(qss.indexOf(prefix));
+    while (pos >= 0) {
+        int token = -1;
+        for (int i = 0; i < TokenCount; ++i) {
+            if (matchesAt(qss, pos + 2, names[i])) {
+                token = i;
+                break;
+            }
+        }
+
+        if (token < 0) {
+            pos = static_cast<int>(qss.indexOf(prefix, pos + 1));
+            continue;
+        }
+
+        const int tokenLength = 2 + static_cast<int>(names[token].size());
+        if (pos > literalStart) {
+            t.segments_.append(Segment{-1, literalStart, pos - literalStart});
+            t.literalLength_ += pos - literalStart;
+        }
+        t.segments_.append(Segment{token, pos, tokenLength});
+        ++t.tokenCount_;
+
+        literalStart = pos + tokenLength;
+        pos = static_cast<int>(qss.indexOf(prefix, literalStart));
+    }
+
+    const int length = static_cast<int>(qss.size());
+    if (literalStart < length) {
+        t.segments_.append(Segment{-1, literalStart, length - literalStart});
+        t.literalLength_ += length - literalStart;
+    }
+
+    return t;
+}
+
+QString QssTemplate::render(const TokenValues& values) const {
+    if (tokenCount_ == 0) {
+        return source_;
+    }
+
+    int size = literalLength_;
+    for (const Segment& seg : segments_) {
+        if (seg.token >= 0) {
+            size += static_cast<int>(values[seg.token].size());
+        }
+    }
+
+    QString result;
+    result.reserve(size);
+    for (const Segment& seg : segments_) {
+        if (seg.token >= 0) {
+            result += values[seg.token];
+        } else {
+            result.append(source_.constData() + seg.start, seg.length);
+        }
+    }
+    return result;
+}
+
+QDataStream& operator<<(QDataStream& out, const QssTemplate& t) {
+    out << t.source_.toUtf8() << static_cast<quint32>(t.segments_.size());
+    for (const QssTemplate::Segment& seg : t.segments_) {
+        out << static_cast<qint8>(seg.token) << static_cast<quint32>(seg.start)
+            << static_cast<quint32>(seg.length);
+    }
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, QssTemplate& t) {
+    t = QssTemplate();
+
+    QByteArray utf8;
+    quint32 count = 0;
+    in >> utf8 >> count;
+    t.source_ = QString::fromUtf8(utf8);
+
+    t.segments_.reserve(static_cast<int>(count));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        qint8 token = -1;
+        quint32 start = 0, length = 0;
+        in >> token >> start >> length;
+        if (token >= QssTemplate::TokenCount ||
+            start + length > static_cast<quint32>(t.source_.size())) {
+            in.setStatus(QDataStream::ReadCorruptData);
+            break;
+        }
+
+        t.segments_.append(QssTemplate::Segment{token, static_cast<int>(start),
+                                                static_cast<int>(length)});
+        if (token >= 0) {
+            ++t.tokenCount_;
+        } else {
+            t.literalLength_ += static_cast<int>(length);
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        t = QssTemplate();
+    }
+    return in;
+}
+
+static const quint32 kBundleMagic = 0x51465043;  // "QFPC"
+static const quint32 kBundleFormat = 1;
+
+QByteArray writeQssTemplateBundle(const QList<QPair<QString, QssTemplate>>& templates,
+                                  size_t signature) {
+    QByteArray blob;
+    QDataStream out(&blob, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_5_15);
+
+    out << kBundleMagic << kBundleFormat << static_cast<quint64>(signature)
+        << static_cast<quint32>(templates.size());
+    for (const auto& entry : templates) {
+        out << entry.first << entry.second;
+    }
+    return blob;
+}
+
+bool readQssTemplateBundle(const QByteArray& blob, QHash<QString, QssTemplate>* templates,
+                           size_t* signature) {
+    QDataStream in(blob);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0, format = 0, count = 0;
+    quint64 sig = 0;
+    in >> magic >> format >> sig >> count;
+    if (magic != kBundleMagic || format != kBundleFormat) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        QssTemplate t;
+        in >> path >> t;
+        if (in.status() == QDataStream::Ok) {
+            templates->insert(path, t);
+        }
+    }
+
+    *signature = static_cast<size_t>(sig);
+    return in.status() == QDataStream::Ok;
+}
+
+static inline bool isWordChar(QChar c) {
+    const auto u = c.unicode();
+    if (u < 0x80) {
+        return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') || (u >= '0' && u <= '9') ||
+               u == '_';
+    }
+    return c.isLetterOrNumber();
+}
+
+QStringList QssSelectorRewriter::builtInClassTypes() {
+    return {
+        QStringLiteral("LineEdit"),
+        QStringLiteral("TextEdit"),
+        QStringLiteral("PlainTextEdit"),
+        QStringLiteral("TextBrowser"),
+        QStringLiteral("InfoBadge"),
+        QStringLiteral("PrimaryPushButton"),
+        QStringLiteral("PrimaryToolButton"),
+        QStringLiteral("PrimaryDropDownPushButton"),
+        QStringLiteral("PrimaryDropDownToolButton"),
+        QStringLiteral("TransparentPushButton"),
+        QStringLiteral("TransparentToolButton"),
+        QStringLiteral("TransparentTogglePushButton"),
+        QStringLiteral("TransparentToggleToolButton"),
+        QStringLiteral("TransparentDropDownPushButton"),
+        QStringLiteral("TransparentDropDownToolButton"),
+        QStringLiteral("ToggleButton"),
+        QStringLiteral("ToggleToolButton"),
+        QStringLiteral("TogglePushButton"),
+        QStringLiteral("DropDownPushButton"),
+        QStringLiteral("DropDownToolButton"),
+        QStringLiteral("HyperlinkButton"),
+        QStringLiteral("HyperlinkLabel"),
+        QStringLiteral("ToolButton"),
+        QStringLiteral("RadioButton"),
+        QStringLiteral("PillPushButton"),
+        QStringLiteral("PillToolButton"),
+        QStringLiteral("SplitDropButton"),
+        QStringLiteral("PrimarySplitDropButton"),
+        QStringLiteral("PushButton"),
+        QStringLiteral("TabBar"),
+        QStringLiteral("SimpleCardWidget"),
+        QStringLiteral("ElevatedCardWidget"),
+        QStringLiteral("HeaderCardWidget"),
+        QStringLiteral("GroupHeaderCardWidget"),
+        QStringLiteral("StateToolTip"),
+        QStringLiteral("ToastToolTip"),
+        QStringLiteral("SpinBox"),
+        QStringLiteral("DoubleSpinBox"),
+        QStringLiteral("CompactSpinBox"),
+        QStringLiteral("CompactDoubleSpinBox"),
+        QStringLiteral("SpinButton"),
+        QStringLiteral("DateEdit"),
+        QStringLiteral("DateTimeEdit"),
+        QStringLiteral("TimeEdit"),
+        QStringLiteral("PivotItem"),
+        QStringLiteral("Pivot"),
+        QStringLiteral("SegmentedItem"),
+        QStringLiteral("SegmentedToolItem"),
+        QStringLiteral("SegmentedWidget"),
+        QStringLiteral("SegmentedToolWidget"),
+        QStringLiteral("SegmentedToggleToolItem"),
+        QStringLiteral("SegmentedToggleToolWidget"),
+        QStringLiteral("ScrollButton"),
+        QStringLiteral("CalendarPicker"),
+        QStringLiteral("CalendarViewBase"),
+        QStringLiteral("ScrollViewBase"),
+        QStringLiteral("CycleListWidget"),
+        QStringLiteral("PickerPanel"),
+        QStringLiteral("SeparatorWidget"),
+        QStringLiteral("ItemMaskWidget"),
+        QStringLiteral("PickerBase"),
+        QStringLiteral("DatePicker"),
+        QStringLiteral("ZhDatePicker"),
+        QStringLiteral("SettingCard"),
+        QStringLiteral("SwitchSettingCard"),
+        QStringLiteral("RangeSettingCard"),
+        QStringLiteral("PushSettingCard"),
+        QStringLiteral("PrimaryPushSettingCard"),
+        QStringLiteral("HyperlinkCard"),
+        QStringLiteral("ColorPickerButton"),
+        QStringLiteral("ColorSettingCard"),
+        QStringLiteral("ComboBoxSettingCard"),
+        QStringLiteral("SettingCardGroup"),
+        QStringLiteral("ExpandSettingCard"),
+        QStringLiteral("ExpandGroupSettingCard"),
+        QStringLiteral("SimpleExpandGroupSettingCard"),
+        QStringLiteral("CustomColorSettingCard"),
+        QStringLiteral("OptionsSettingCard"),
+        QStringLiteral("FolderListSettingCard"),
+        QStringLiteral("StackedWidget"),
+        // Title bar types - need qssClass because metaObject className includes namespace prefix
+        QStringLiteral("FluentTitleBar"),
+        QStringLiteral("SplitTitleBar"),
+        QStringLiteral("MSFluentTitleBar"),
+        // Label types - need qssClass for type selector matching
+        QStringLiteral("FluentLabelBase"),
+        QStringLiteral("CaptionLabel"),
+        QStringLiteral("BodyLabel"),
+        QStringLiteral("StrongBodyLabel"),
+        QStringLiteral("SubtitleLabel"),
+        QStringLiteral("TitleLabel"),
+        QStringLiteral("LargeTitleLabel"),
+        QStringLiteral("DisplayLabel"),
+    };
+}
+
+QssSelectorRewriter::QssSelectorRewriter() {
+    // Special replacements with custom selectors take precedence over registered types
+    addRule(QStringLiteral("RoundMenu"), QStringLiteral("QMenu[qssClass=\"RoundMenu\"]"));
+    addRule(QStringLiteral("MenuActionListWidget"),
+            QStringLiteral("QListWidget[qssClass=\"MenuActionListWidget\"]"));
+    addRule(QStringLiteral("ComboBox"), QStringLiteral("*[comboBox=true]"));
+    addRule(QStringLiteral("ModelComboBox"), QStringLiteral("*[modelComboBox=true]"));
+    addRule(QStringLiteral("InfoBar"), QStringLiteral("*[infoBar=true]"));
+
+    const QStringList types = builtInClassTypes();
+    rules_.reserve(rules_.size() + types.size());
+    for (const QString& type : types) {
+        addClassType(type);
+    }
+}
+
+bool QssSelectorRewriter::addRule(const QString& name, const QString& replacement) {
+    if (name.isEmpty() || index_.contains(QStringView(name))) {
+        return false;
+    }
+
+    rules_.append(Rule{name, replacement});
+    signature_ += qHash(name) * 31 + qHash(replacement);
+    // The view points at the string's shared buffer, which stays put when rules_ reallocates.
+    index_.insert(QStringView(rules_.constLast().name), static_cast<int>(rules_.size()) - 1);
+    return true;
+}
+
+bool QssSelectorRewriter::addClassType(const QString& typeName) {
+    return addRule(typeName,
+                   QStringLiteral("*[qssClass=\"") + typeName + QStringLiteral("\"]"));
+}
+
+QString QssSelectorRewriter::rewrite(const QString& qss) const {
+    static const QString qssClassPrefix = QStringLiteral("qssClass=\"");
+    const QStringView prefix(qssClassPrefix);
+
+    const QChar* data = qss.constData();
+    const int n = static_cast<int>(qss.size());
+
+    QString result;
+    bool rewritten = false;
+    int copied = 0;
+    int i = 0;
+    while (i < n) {
+        if (!isWordChar(data[i])) {
+            ++i;
+            continue;
+        }
+
+        const int start = i;
+        while (i < n && isWordChar(data[i])) {
+            ++i;
+        }
+
+        const auto it = index_.constFind(QStringView(data + start, i - start));
+        if (it == index_.constEnd()) {
+            continue;
+        }
+
+        // Avoid replacing inside existing qssClass attribute values, e.g.
+        // *[qssClass="SettingInterface"]  (otherwise we'd produce invalid nested selectors)
+        if (start >= prefix.size() &&
+            QStringView(data + start - prefix.size(), prefix.size()) == prefix) {
+            continue;
+        }
+
+        if (!rewritten) {
+            result.reserve(n + n / 4);
+            rewritten = true;
+        }
+        result.append(data + copied, start - copied);
+        result += rules_[it.value()].replacement;
+        copied = i;
+    }
+
+    if (!rewritten) {
+        return qss;
+    }
+
+    result.append(data + copied, n - copied);
+    return result;
+}
+
+}  // namespace qfw
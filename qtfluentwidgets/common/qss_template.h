@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QVector>
+#include <array>
+
+class QDataStream;
+
+namespace qfw {
+
+// A QSS source split once into literal chunks and theme token slots, so rendering for a
+// given theme/color is a single concatenation instead of one replace() pass per token.
+class QssTemplate {
+public:
+    enum Token {
+        FontFamilies,
+        ThemeColorPrimary,
+        ThemeColorDark1,
+        ThemeColorDark2,
+        ThemeColorDark3,
+        ThemeColorLight1,
+        ThemeColorLight2,
+        ThemeColorLight3,
+        TokenCount
+    };
+
+    using TokenValues = std::array<QString, TokenCount>;
+
+    struct Segment {
+        int token = -1;  // -1: literal text source_[start, start + length)
+        int start = 0;
+        int length = 0;
+    };
+
+    QssTemplate() = default;
+
+    // Splits |qss| on "--<TokenName>" occurrences; everything else is kept verbatim.
+    static QssTemplate compile(const QString& qss);
+
+    // Name of a token without the leading "--", e.g. "ThemeColorDark1".
+    static QString tokenName(Token token);
+
+    QString render(const TokenValues& values) const;
+
+    bool hasTokens() const { return tokenCount_ > 0; }
+    const QString& source() const { return source_; }
+    const QVector<Segment>& segments() const { return segments_; }
+
+    // Compact serialized form (UTF-8 source plus segment table) written by the build-time
+    // qss precompiler and read back at runtime without re-scanning for tokens.
+    friend QDataStream& operator<<(QDataStream& out, const QssTemplate& t);
+    friend QDataStream& operator>>(QDataStream& in, QssTemplate& t);
+
+private:
+    QString source_;
+    QVector<Segment> segments_;
+    int literalLength_ = 0;
+    int tokenCount_ = 0;
+};
+
+// Rewrites widget type selectors in one pass over the sheet. Every identifier is looked up
+// in a prebuilt table, e.g. PushButton -> *[qssClass="PushButton"], ComboBox -> *[comboBox=true];
+// identifiers that are already a qssClass="..." value are left alone.
+class QssSelectorRewriter {
+public:
+    QssSelectorRewriter();
+
+    // Adds a type rewritten to *[qssClass="typeName"]; returns false if it is already known.
+    bool addClassType(const QString& typeName);
+
+    QString rewrite(const QString& qss) const;
+
+    // Order-independent fingerprint of the rule table; changes whenever a type is added.
+    size_t signature() const { return signature_; }
+
+    static QStringList builtInClassTypes();
+
+private:
+    struct Rule {
+        QString name;
+        QString replacement;
+    };
+
+    bool addRule(const QString& name, const QString& replacement);
+
+    QVector<Rule> rules_;
+    QHash<QStringView, int> index_;  // views into rules_[i].name
+    size_t signature_ = 0;
+};
+
+// Bundle of precompiled templates keyed by resource path, as emitted by tools/qss_compiler.
+// |signature| is the QssSelectorRewriter::signature() the sheets were rewritten with.
+QByteArray writeQssTemplateBundle(const QList<QPair<QString, QssTemplate>>& templates,
+                                  size_t signature);
+bool readQssTemplateBundle(const QByteArray& blob, QHash<QString, QssTemplate>* templates,
+                           size_t* signature);
+
+}  // namespace qfw
@@ -2,6 +2,7 @@
 #if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
 typedef qintptr nativeEvent_qintptr;
 typedef float QColor_HsvF_type;
+typedef size_t qHash_result_type;
 
 #define QLocale_territory territory
 #define QVariant_typeId typeId
@@ -12,6 +13,7 @@ typedef float QColor_HsvF_type;
 #else
 typedef long nativeEvent_qintptr;
 typedef qreal QColor_HsvF_type;
+typedef uint qHash_result_type;
 
 #define QLocale_territory country
 #define QVariant_typeId type
@@ -14,10 +14,25 @@ SmoothScroll::SmoothScroll(QAbstractScrollArea* widget, Qt::Orientation orient,
     : QObject(parent), widget_(widget), orient_(orient) {
     // Setup timer - no event filter, will be called directly by SmoothScrollDelegate
     smoothMoveTimer_.setSingleShot(false);
+    smoothMoveTimer_.setTimerType(Qt::PreciseTimer);
+    clock_.start();
     connect(&smoothMoveTimer_, &QTimer::timeout, this, &SmoothScroll::smoothMove);
 }
 
-void SmoothScroll::setSmoothMode(SmoothMode mode) { smoothMode_ = mode; }
+void SmoothScroll::setSmoothMode(SmoothMode mode) {
+    if (smoothMode_ == mode) {
+        return;
+    }
+
+    // Motions queued by one mode mean nothing to the other
+    smoothMode_ = mode;
+    motions_.clear();
+    velocity_ = 0;
+    tracking_ = false;
+    velocitySamples_.clear();
+}
+
+void SmoothScroll::resetFrameStats() { frameStats_ = SmoothScrollFrameStats(); }
 
 void SmoothScroll::wheelEvent(QWheelEvent* e) {
     int delta = e->angleDelta().y() != 0 ? e->angleDelta().y() : e->angleDelta().x();
@@ -33,6 +48,16 @@ void SmoothScroll::wheelEvent(QWheelEvent* e) {
         return;
     }
 
+    if (smoothMode_ == SmoothMode::Kinetic) {
+        handleKineticEvent(e);
+        return;
+    }
+
+    // Phase-only touchpad events only matter to the kinetic mode
+    if (delta == 0) {
+        return;
+    }
+
     // Handle all wheel events with smooth scrolling (including trackpad)
     handleWheelEvent(e);
 }
@@ -40,8 +65,8 @@ void SmoothScroll::wheelEvent(QWheelEvent* e) {
 void SmoothScroll::handleWheelEvent(QWheelEvent* e) {
     int delta = e->angleDelta().y() != 0 ? e->angleDelta().y() : e->angleDelta().x();
 
-    // Push current time to queue
-    qint64 now = QDateTime::currentDateTime().toMSecsSinceEpoch();
+    // Push current time to queue; a monotonic clock avoids a local time conversion per event
+    const double now = elapsedMs();
     scrollStamps_.append(now);
 
     // Remove timestamps older than 500ms
@@ -51,11 +76,6 @@ void SmoothScroll::handleWheelEvent(QWheelEvent* e) {
 
     // Adjust the acceleration ratio based on unprocessed events
     double accelerationRatio = std::min(scrollStamps_.size() / 15.0, 1.0);
-    lastWheelPos_ = e->position().toPoint();
-    lastWheelGlobalPos_ = e->globalPosition().toPoint();
-
-    // Get the number of steps
-    stepsTotal_ = fps_ * duration_ / 1000;
 
     // Get the moving distance corresponding to each event
     double adjustedDelta = delta * stepRatio_;
@@ -63,76 +83,227 @@ void SmoothScroll::handleWheelEvent(QWheelEvent* e) {
         adjustedDelta += adjustedDelta * acceleration_ * accelerationRatio;
     }
 
-    // Form a list of moving distances and steps, and insert it into the queue for processing
-    stepsLeftQueue_.append(qMakePair(adjustedDelta, stepsTotal_));
+    // Queue the motion; it is integrated over elapsed time rather than a fixed step count
+    motions_.append(Motion{adjustedDelta, now, 0.0});
+
+    startTicking();
+}
+
+// Velocity samples older than this don't describe the release any more
+static constexpr double kVelocityWindowMs = 100;
+// Below this speed (pixels per ms) the coasting motion stops
+static constexpr double kMinVelocity = 0.02;
+
+void SmoothScroll::handleKineticEvent(QWheelEvent* e) {
+    const double now = elapsedMs();
+    const QPoint pixels = e->pixelDelta();
+    const QPoint angle = e->angleDelta();
+
+    switch (e->phase()) {
+        case Qt::ScrollBegin:
+            // Fingers down: catch the view
+            tracking_ = true;
+            velocity_ = 0;
+            velocitySamples_.clear();
+            break;
+        case Qt::ScrollUpdate:
+            if (!pixels.isNull()) {
+                const double delta = orient_ == Qt::Vertical ? pixels.y() : pixels.x();
+                if (!tracking_) {
+                    tracking_ = true;
+                    velocity_ = 0;
+                    velocitySamples_.clear();
+                }
+                velocitySamples_.append(qMakePair(now, delta));
+                while (now - velocitySamples_.first().first > kVelocityWindowMs) {
+                    velocitySamples_.removeFirst();
+                }
+                scrollBy(delta, true);
+            }
+            break;
+        case Qt::ScrollMomentum:
+        case Qt::ScrollEnd:
+            // Coast with our own decay; the platform's momentum events are dropped
+            if (tracking_) {
+                tracking_ = false;
+                velocity_ = 0;
+                if (!velocitySamples_.isEmpty() &&
+                    now - velocitySamples_.last().first <= kVelocityWindowMs) {
+                    double distance = 0;
+                    for (const auto& sample : velocitySamples_) {
+                        distance += sample.second;
+                    }
+                    const double span =
+                        qMax(now - velocitySamples_.first().first, double(frameInterval()));
+                    velocity_ = distance / span;
+                }
+                velocitySamples_.clear();
+                if (qAbs(velocity_) >= kMinVelocity) {
+                    startTicking();
+                }
+            }
+            break;
+        case Qt::NoScrollPhase: {
+            // Mouse wheel: an impulse whose coasting distance is the usual step
+            double delta = 0;
+            if (!pixels.isNull()) {
+                delta = orient_ == Qt::Vertical ? pixels.y() : pixels.x();
+            } else {
+                delta = (angle.y() != 0 ? angle.y() : angle.x()) * stepRatio_ * wheelStepPixels();
+            }
+            if (delta != 0) {
+                velocity_ += delta / decayMs_;
+                startTicking();
+            }
+            break;
+        }
+    }
+}
+
+void SmoothScroll::kineticMove(double now) {
+    if (tracking_ || lastFrameMs_ < 0) {
+        return;
+    }
+
+    // Integrate v0 * exp(-t / tau) exactly over the elapsed time
+    const double dt = now - lastFrameMs_;
+    const double decay = std::exp(-dt / decayMs_);
+    const double delta = velocity_ * decayMs_ * (1 - decay);
+    velocity_ *= decay;
+
+    // Clamp at the ends of the range instead of overscrolling
+    if (!scrollBy(delta, true) || qAbs(velocity_) < kMinVelocity) {
+        velocity_ = 0;
+    }
+}
 
-    // Start timer: 1000ms/frames
-    smoothMoveTimer_.start(1000 / fps_);
+void SmoothScroll::startTicking() {
+    // Tick once per display frame
+    const int interval = frameInterval();
+    if (!smoothMoveTimer_.isActive() || smoothMoveTimer_.interval() != interval) {
+        smoothMoveTimer_.start(interval);
+    }
 }
 
 void SmoothScroll::smoothMove() {
+    const double now = elapsedMs();
+
+    if (smoothMode_ == SmoothMode::Kinetic) {
+        kineticMove(now);
+        recordFrame(now);
+        if (velocity_ == 0) {
+            smoothMoveTimer_.stop();
+            lastFrameMs_ = -1;
+            subPixel_ = 0;
+        }
+        return;
+    }
+
+    recordFrame(now);
+
     double totalDelta = 0;
 
-    // Calculate the scrolling distance of all unprocessed events
-    for (auto& item : stepsLeftQueue_) {
-        totalDelta += subDelta(item.first, item.second, stepsTotal_);
-        item.second--;
+    // Scroll the share of every motion that its easing curve covers up to now, so late or
+    // early ticks don't change the distance travelled
+    for (Motion& motion : motions_) {
+        const double t = qBound(0.0, (now - motion.startMs) / duration_, 1.0);
+        const double progress = easedProgress(t);
+        totalDelta += motion.delta * (progress - motion.progress);
+        motion.progress = progress;
     }
 
     // If the event has been processed, move it out of the queue
-    while (!stepsLeftQueue_.isEmpty() && stepsLeftQueue_.first().second == 0) {
-        stepsLeftQueue_.removeFirst();
+    while (!motions_.isEmpty() && now - motions_.first().startMs >= duration_) {
+        motions_.removeFirst();
     }
 
-    // Construct wheel event
-    QPoint pixelDelta;
-    QScrollBar* bar;
+    // Reached the end of the range, the rest of the queued motion has nowhere to go
+    if (!scrollBy(totalDelta)) {
+        motions_.clear();
+    }
 
-    if (orient_ == Qt::Vertical) {
-        pixelDelta = QPoint(0, std::round(totalDelta));
-        bar = widget_->verticalScrollBar();
-    } else {
-        pixelDelta = QPoint(std::round(totalDelta), 0);
-        bar = widget_->horizontalScrollBar();
+    // Stop scrolling if the queue is empty
+    if (motions_.isEmpty()) {
+        smoothMoveTimer_.stop();
+        lastFrameMs_ = -1;
+        subPixel_ = 0;
     }
+}
 
-    QWheelEvent wheelEvent(lastWheelPos_, lastWheelGlobalPos_, pixelDelta,
-                           QPoint(std::round(totalDelta), 0), Qt::LeftButton, Qt::NoModifier,
-                           Qt::ScrollBegin, false);
+// Moves the scroll bar directly instead of dispatching a synthetic wheel event through every
+// event filter; the fractional part is carried over so slow motions don't round to nothing.
+// Wheel units are converted like QAbstractSlider does for wheel events: 120 units scroll
+// wheelScrollLines() single steps. Pixel deltas are applied 1:1. Either way at most a page
+// is scrolled at a time. Returns false if the bar is already at the end of its range.
+bool SmoothScroll::scrollBy(double delta, bool pixels) {
+    QScrollBar* bar = scrollBar();
+    subPixel_ += pixels ? delta : delta * wheelStepPixels();
+    int step = static_cast<int>(subPixel_);
+    subPixel_ -= step;
 
-    // Send wheel event to app
-    QApplication::sendEvent(bar, &wheelEvent);
+    const int pageStep = bar->pageStep();
+    if (pageStep > 0) {
+        step = qBound(-pageStep, step, pageStep);
+    }
 
-    // Stop scrolling if the queue is empty
-    if (stepsLeftQueue_.isEmpty()) {
-        smoothMoveTimer_.stop();
+    if (step == 0) {
+        return true;
     }
+
+    const int value = bar->value();
+    bar->setValue(value - step);
+    return bar->value() != value;
 }
 
-double SmoothScroll::subDelta(double delta, int stepsLeft, int stepsTotal) const {
-    int m = stepsTotal / 2;
-    int x = std::abs(stepsTotal - stepsLeft - m);
+QScrollBar* SmoothScroll::scrollBar() const {
+    return orient_ == Qt::Vertical ? widget_->verticalScrollBar() : widget_->horizontalScrollBar();
+}
+
+// Pixels scrolled per wheel unit
+double SmoothScroll::wheelStepPixels() const {
+    return QApplication::wheelScrollLines() * scrollBar()->singleStep() / 120.0;
+}
+
+int SmoothScroll::frameInterval() const {
+    const QScreen* screen = widget_ ? widget_->screen() : nullptr;
+    const qreal rate = screen ? screen->refreshRate() : 0;
+    return qMax(1, qRound(1000.0 / (rate >= 1 ? rate : 60.0)));
+}
+
+double SmoothScroll::elapsedMs() const { return clock_.nsecsElapsed() / 1e6; }
+
+// Integral of the easing curve over [0, t], normalized so that t = 1 covers the whole delta
+double SmoothScroll::easedProgress(double t) const {
+    const double u = 2 * t - 1;
 
-    double result = 0;
     switch (smoothMode_) {
         case SmoothMode::NoSmooth:
-            result = 0;
-            break;
+        case SmoothMode::Kinetic:
+            return 0;
         case SmoothMode::Constant:
-            result = delta / stepsTotal;
-            break;
+            return t;
         case SmoothMode::Linear:
-            result = 2 * delta / stepsTotal * (m - x) / m;
-            break;
+            return t < 0.5 ? 2 * t * t : 1 - 2 * (1 - t) * (1 - t);
         case SmoothMode::Quadratic:
-            result = 3.0 / 4.0 / m * (1 - x * x / (double)m / m) * delta;
-            break;
+            return 0.5 + 0.75 * (u - u * u * u / 3);
         case SmoothMode::Cosine:
-            result = (std::cos(x * M_PI / m) + 1) / (2 * m) * delta;
-            break;
+            return (u + 1) / 2 + std::sin(u * M_PI) / (2 * M_PI);
     }
 
-    return result;
+    return t;
+}
+
+void SmoothScroll::recordFrame(double now) {
+    if (lastFrameMs_ >= 0) {
+        const double frameMs = now - lastFrameMs_;
+        ++frameStats_.frames;
+        frameStats_.averageFrameMs += (frameMs - frameStats_.averageFrameMs) / frameStats_.frames;
+        frameStats_.maxFrameMs = qMax(frameStats_.maxFrameMs, frameMs);
+        if (frameMs > 1.5 * smoothMoveTimer_.interval()) {
+            ++frameStats_.lateFrames;
+        }
+    }
+    lastFrameMs_ = now;
 }
 
 }  // namespace qfw
@@ -2,7 +2,7 @@
 
 #include <QAbstractScrollArea>
 #include <QApplication>
-#include <QDateTime>
+#include <QElapsedTimer>
 #include <QLocale>
 #include <QPoint>
 #include <QRect>
@@ -13,7 +13,24 @@
 
 namespace qfw {
 
-enum class SmoothMode { NoSmooth = 0, Constant = 1, Linear = 2, Quadratic = 3, Cosine = 4 };
+// Kinetic follows touchpad pixel deltas 1:1 and, once the fingers lift, coasts with the
+// estimated release velocity under exponential decay; wheel notches become velocity impulses.
+enum class SmoothMode {
+    NoSmooth = 0,
+    Constant = 1,
+    Linear = 2,
+    Quadratic = 3,
+    Cosine = 4,
+    Kinetic = 5
+};
+
+// Frame timing of a SmoothScroll, measured between consecutive animation ticks
+struct SmoothScrollFrameStats {
+    int frames = 0;
+    double averageFrameMs = 0;
+    double maxFrameMs = 0;
+    int lateFrames = 0;  // ticks that arrived more than 1.5 frame intervals after the previous
+};
 
 class SmoothScroll : public QObject {
     Q_OBJECT
@@ -25,25 +42,51 @@ public:
     void setSmoothMode(SmoothMode mode);
     void wheelEvent(QWheelEvent* e);
 
+    SmoothScrollFrameStats frameStats() const { return frameStats_; }
+    void resetFrameStats();
+
 private slots:
     void smoothMove();
 
 private:
+    // One wheel notch being eased out over duration_
+    struct Motion {
+        double delta;
+        double startMs;
+        double progress;  // integrated share of delta already scrolled, 0..1
+    };
+
     void handleWheelEvent(QWheelEvent* e);
-    double subDelta(double delta, int stepsLeft, int stepsTotal) const;
+    void handleKineticEvent(QWheelEvent* e);
+    void kineticMove(double now);
+    void startTicking();
+    bool scrollBy(double delta, bool pixels = false);
+    QScrollBar* scrollBar() const;
+    double wheelStepPixels() const;
+    int frameInterval() const;
+    double easedProgress(double t) const;
+    double elapsedMs() const;
+    void recordFrame(double now);
 
     QAbstractScrollArea* widget_;
     Qt::Orientation orient_;
-    int fps_ = 60;
     int duration_ = 400;
-    int stepsTotal_ = 0;
     double stepRatio_ = 1.5;
     int acceleration_ = 1;
 
-    QPoint lastWheelPos_;
-    QPoint lastWheelGlobalPos_;
     QList<double> scrollStamps_;
-    QList<QPair<double, int>> stepsLeftQueue_;
+    QList<Motion> motions_;
+    double subPixel_ = 0;  // fractional pixels not yet applied to the scroll bar
+
+    // Kinetic mode
+    double decayMs_ = 325;  // time constant of the velocity decay
+    double velocity_ = 0;   // pixels per ms, same sign as wheel deltas
+    bool tracking_ = false; // fingers are on the touchpad
+    QList<QPair<double, double>> velocitySamples_;  // (time, pixel delta) while tracking
+
+    QElapsedTimer clock_;
+    double lastFrameMs_ = -1;
+    SmoothScrollFrameStats frameStats_;
 
     SmoothMode smoothMode_ = SmoothMode::Linear;
     QTimer smoothMoveTimer_;
@@ -1,7 +1,9 @@
 #include "common/style_sheet.h"
 
 #include <QApplication>
+#include <QDataStream>
 #include <QDebug>
+#include <QDir>
 #include <QDynamicPropertyChangeEvent>
 #include <QElapsedTimer>
 #include <QEvent>
@@ -11,16 +13,33 @@
 #include <QMessageLogContext>
 #include <QRegion>
 #include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QStringView>
 #include <QStyleFactory>
 #include <QWidget>
 #include <algorithm>
 #include <utility>
 
+#include "common/qss_template.h"
 #include "common/qtcompat.h"
 
+#ifndef QFW_VERSION
+#define QFW_VERSION "unknown"
+#endif
+
+#ifndef QFW_QSS_HASH
+#define QFW_QSS_HASH ""
+#endif
+
 namespace qfw {
 
-static QString applyThemeColorTokens(const QString& qss);
+#ifdef QFW_PRECOMPILED_QSS
+// Generated by tools/qss_compiler.cpp
+QByteArray precompiledQssBlob();
+#endif
+
+static QString renderQss(const QString& qss);
 static QString fixTypeSelectors(const QString& qss);
 
 static QHash<QString, QString>& rawQssCache() {
@@ -28,13 +47,14 @@ static QHash<QString, QString>& rawQssCache() {
     return c;
 }
 
-static QHash<QString, QRegularExpression>& typeSelectorRegexCache() {
-    static QHash<QString, QRegularExpression> c;
+static QHash<QString, QString>& renderedQssCache() {
+    static QHash<QString, QString> c;
     return c;
 }
 
-static QHash<QString, QString>& renderedQssCache() {
-    static QHash<QString, QString> c;
+// Selector-fixed, token-split templates keyed by qss path; independent of theme and color.
+static QHash<QString, QSharedPointer<const QssTemplate>>& qssTemplateCache() {
+    static QHash<QString, QSharedPointer<const QssTemplate>> c;
     return c;
 }
 
@@ -49,11 +69,18 @@ struct QssPerfStats {
     int widgetsDeadRemoved = 0;
     int widgetsLazySkipped = 0;
     int widgetsApplied = 0;
+    int widgetsApplySkipped = 0;  // applies avoided because the widget already had the sheet
+    int hashCollisions = 0;       // hash matched but the content did not
     int widgetsNoSource = 0;
 
     qint64 getStyleMs = 0;
     int renderedCacheHit = 0;
     int renderedCacheMiss = 0;
+    int templateCompiled = 0;
+    int diskCacheHit = 0;
+    int composeCacheHit = 0;
+    int composeCacheShared = 0;
+    int composeCacheMiss = 0;
 
     qint64 getWidgetStyleMs = 0;  // widget->styleSheet() 调用
     qint64 compareMs = 0;         // 字符串比较
@@ -67,10 +94,30 @@ static QssPerfStats& qssPerfStats() {
     return s;
 }
 
+// Bumped whenever previously rendered QSS may no longer be valid for the same theme state.
+static quint64& qssEpoch() {
+    static quint64 epoch = 1;
+    return epoch;
+}
+
+static QHash<QString, QString>& composedQssCache() {
+    static QHash<QString, QString> c;
+    return c;
+}
+
+// Hoistable forms of bundled and file sheets, by rendered-sheet key.
+static QHash<QString, QString>& sharedQssCache() {
+    static QHash<QString, QString> c;
+    return c;
+}
+
 static void invalidateQssCaches() {
+    ++qssEpoch();
+    composedQssCache().clear();
     rawQssCache().clear();
     renderedQssCache().clear();
-    typeSelectorRegexCache().clear();
+    qssTemplateCache().clear();
+    sharedQssCache().clear();
 
     if (qssDebugEnabled()) {
         qDebug() << "[qfw][qss] caches invalidated";
@@ -78,48 +125,73 @@ static void invalidateQssCaches() {
 }
 
 static bool setStyleSheetIfChanged(QWidget* widget, const QString& qss) {
-    if (!widget) {
-        return false;
-    }
-
-    QElapsedTimer timer;
-    if (qssDebugEnabled()) {
-        timer.start();
-    }
-
-    const QString currentStyle = widget->styleSheet();
-    if (qssDebugEnabled()) {
-        qssPerfStats().getWidgetStyleMs += timer.elapsed();
-        timer.restart();
-    }
-
-    const bool same = (qss.trimmed() == currentStyle.trimmed());
-    if (qssDebugEnabled()) {
-        qssPerfStats().compareMs += timer.elapsed();
-    }
+    return StyleSheetManager::instance().applyStyleSheet(widget, qss);
+}
 
-    if (same) {
-        return false;
+// Widgets mostly receive the same shared rendered string, so remember the last one hashed.
+static size_t qssContentHash(const QString& qss) {
+    static QString last;
+    static size_t lastHash = 0;
+    if (!last.isNull() && last.constData() == qss.constData() && last.size() == qss.size()) {
+        return lastHash;
     }
+    last = qss;
+    lastHash = qHash(qss);
+    return lastHash;
+}
 
-    widget->setStyleSheet(qss);
-    if (qssDebugEnabled()) {
-        qssPerfStats().setStyleMs += timer.elapsed();
-    }
-    return true;
+static void dumpQssPerfStats() {
+    const QssPerfStats& s = qssPerfStats();
+    qDebug().noquote() << QStringLiteral(
+                              "[qfw][qss] update: %1 ms, widgets=%2 applied=%3 skipped=%4 "
+                              "(hash collisions=%5) lazy=%6 dead=%7 noSource=%8")
+                              .arg(s.updateMs)
+                              .arg(s.widgetsTotal)
+                              .arg(s.widgetsApplied)
+                              .arg(s.widgetsApplySkipped)
+                              .arg(s.hashCollisions)
+                              .arg(s.widgetsLazySkipped)
+                              .arg(s.widgetsDeadRemoved)
+                              .arg(s.widgetsNoSource);
+    qDebug().noquote() << QStringLiteral(
+                              "[qfw][qss] getStyle: %1 ms, rendered hit=%2 miss=%3, compose "
+                              "hit=%4 shared=%5 miss=%6, templates=%7 disk hit=%8")
+                              .arg(s.getStyleMs)
+                              .arg(s.renderedCacheHit)
+                              .arg(s.renderedCacheMiss)
+                              .arg(s.composeCacheHit)
+                              .arg(s.composeCacheShared)
+                              .arg(s.composeCacheMiss)
+                              .arg(s.templateCompiled)
+                              .arg(s.diskCacheHit);
+    qDebug().noquote() << QStringLiteral(
+                              "[qfw][qss] apply: read %1 ms, compare %2 ms, setStyleSheet %3 ms")
+                              .arg(s.getWidgetStyleMs)
+                              .arg(s.compareMs)
+                              .arg(s.setStyleMs);
+
+    quint64 darkLookups = 0;
+    quint64 paletteReads = 0;
+    isDarkThemeStats(&darkLookups, &paletteReads);
+    qDebug().noquote() << QStringLiteral("[qfw][qss] isDarkTheme: auto lookups=%1 palette reads=%2")
+                              .arg(darkLookups)
+                              .arg(paletteReads);
 }
 
-static QSet<QString>& externalQssClassTypes() {
-    static QSet<QString> s;
-    return s;
+// Built once; registerQssClassType() extends the table in place instead of rebuilding it.
+static QssSelectorRewriter& typeSelectorRewriter() {
+    static QssSelectorRewriter r;
+    return r;
 }
 
 void registerQssClassType(const QString& typeName) {
-    if (typeName.trimmed().isEmpty()) {
+    const QString trimmed = typeName.trimmed();
+    if (trimmed.isEmpty()) {
         return;
     }
-    externalQssClassTypes().insert(typeName.trimmed());
-    invalidateQssCaches();
+    if (typeSelectorRewriter().addClassType(trimmed)) {
+        invalidateQssCaches();
+    }
 }
 
 void registerQssClassTypes(const QStringList& typeNames) {
@@ -129,8 +201,7 @@ void registerQssClassTypes(const QStringList& typeNames) {
         if (trimmed.isEmpty()) {
             continue;
         }
-        if (!externalQssClassTypes().contains(trimmed)) {
-            externalQssClassTypes().insert(trimmed);
+        if (typeSelectorRewriter().addClassType(trimmed)) {
             added = true;
         }
     }
@@ -170,32 +241,17 @@ static QString renderedCacheKeyForPath(const QString& themedPath) {
 }
 
 QString getStyleSheet(const StyleSheetBase& source, Theme theme) {
-    if (const auto* file = dynamic_cast<const StyleSheetFile*>(&source)) {
-        return getStyleSheet(file->path(), theme);
+    if (const auto* compose = dynamic_cast<const StyleSheetCompose*>(&source)) {
+        return compose->styleSheet(theme);
     }
     if (const auto* fluent = dynamic_cast<const FluentStyleSheetSource*>(&source)) {
         return getStyleSheet(styleSheetPath(fluent->sheet(), theme), theme);
     }
-
-    if (const auto* compose = dynamic_cast<const StyleSheetCompose*>(&source)) {
-        QString result;
-        for (const auto& s : compose->sources()) {
-            if (!s) {
-                continue;
-            }
-            const QString part = getStyleSheet(*s, theme);
-            if (part.isEmpty()) {
-                continue;
-            }
-            if (!result.isEmpty()) {
-                result += QLatin1Char('\n');
-            }
-            result += part;
-        }
-        return result;
+    if (const auto* file = dynamic_cast<const StyleSheetFile*>(&source)) {
+        return getStyleSheet(file->path(), theme);
     }
 
-    return fixTypeSelectors(applyThemeColorTokens(source.content(theme)));
+    return renderQss(source.content(theme));
 }
 
 static QString sheetName(FluentStyleSheet sheet) {
@@ -381,6 +437,121 @@ QString StyleSheetCompose::content(Theme theme) const {
     return result;
 }
 
+// Everything a rendered compose depends on besides its sources.
+struct QssRenderState {
+    quint64 epoch = 0;
+    QRgb color = 0;
+    int theme = -1;
+    bool dark = false;
+
+    bool operator==(const QssRenderState& other) const {
+        return epoch == other.epoch && color == other.color && theme == other.theme &&
+               dark == other.dark;
+    }
+    bool operator!=(const QssRenderState& other) const { return !(*this == other); }
+};
+
+static QssRenderState currentRenderState(Theme theme) {
+    QssRenderState state;
+    state.epoch = qssEpoch();
+    state.color = QConfig::instance().themeColor().rgba();
+    state.theme = static_cast<int>(theme);
+    state.dark = isDarkTheme();
+    return state;
+}
+
+struct StyleSheetCompose::RenderCache {
+    QssRenderState state;
+    QString qss;
+};
+
+static QssRenderState& composedQssCacheState() {
+    static QssRenderState s;
+    return s;
+}
+
+// Builds a key identifying the rendered output of |sources| independently of the widget they
+// belong to. Returns false if some source (non-empty custom QSS, user subclasses) makes the
+// output widget-specific.
+static bool composeIdentity(const QList<QSharedPointer<StyleSheetBase>>& sources, Theme theme,
+                            QString* key) {
+    for (const auto& s : sources) {
+        if (!s) {
+            continue;
+        }
+        if (const auto* fluent = dynamic_cast<const FluentStyleSheetSource*>(s.data())) {
+            *key += QStringLiteral("s:") + QString::number(static_cast<int>(fluent->sheet()));
+        } else if (const auto* file = dynamic_cast<const StyleSheetFile*>(s.data())) {
+            *key += QStringLiteral("f:") + file->path();
+        } else if (dynamic_cast<const CustomStyleSheet*>(s.data())) {
+            if (!s->content(theme).isEmpty()) {
+                return false;
+            }
+            continue;
+        } else {
+            return false;
+        }
+        *key += QLatin1Char('\n');
+    }
+    return true;
+}
+
+QString StyleSheetCompose::styleSheet(Theme theme) const {
+    const QssRenderState state = currentRenderState(theme);
+    if (cache_ && cache_->state == state) {
+        if (qssDebugEnabled()) {
+            qssPerfStats().composeCacheHit++;
+        }
+        return cache_->qss;
+    }
+
+    QString key;
+    const bool shareable = composeIdentity(sources_, theme, &key);
+    if (shareable && composedQssCacheState() != state) {
+        composedQssCache().clear();
+        composedQssCacheState() = state;
+    }
+
+    QString result;
+    const auto it = shareable ? composedQssCache().constFind(key) : composedQssCache().constEnd();
+    if (it != composedQssCache().constEnd()) {
+        result = it.value();
+        if (qssDebugEnabled()) {
+            qssPerfStats().composeCacheShared++;
+        }
+    } else {
+        for (const auto& s : sources_) {
+            if (!s) {
+                continue;
+            }
+            const QString part = getStyleSheet(*s, theme);
+            if (part.isEmpty()) {
+                continue;
+            }
+            if (!result.isEmpty()) {
+                result += QLatin1Char('\n');
+            }
+            result += part;
+        }
+
+        if (shareable) {
+            composedQssCache().insert(key, result);
+        }
+        if (qssDebugEnabled()) {
+            qssPerfStats().composeCacheMiss++;
+        }
+    }
+
+    if (!cache_) {
+        cache_ = std::make_shared<RenderCache>();
+    }
+    cache_->state = state;
+    cache_->qss = result;
+    return result;
+}
+
+void StyleSheetCompose::invalidate() { cache_.reset(); }
+
 #ifndef NDEBUG
 static void qfwStyleParseMessageHandler(QtMsgType type, const QMessageLogContext& ctx,
                                         const QString& msg) {
@@ -444,51 +615,72 @@ void StyleSheetCompose::add(const QSharedPointer<StyleSheetBase>& source) {
         }
     }
     sources_.append(source);
+    invalidate();
 }
 
 void StyleSheetCompose::remove(const QSharedPointer<StyleSheetBase>& source) {
-    sources_.removeAll(source);
+    if (sources_.removeAll(source) > 0) {
+        invalidate();
+    }
 }
 
-static QColor themedColor(const QColor& base, bool darkTheme, const QString& token) {
+static QColor themedColor(const QColor& base, bool darkTheme, QssTemplate::Token token) {
     QColor_HsvF_type h = 0, s = 0, v = 0, a = 0;
     base.getHsvF(&h, &s, &v, &a);
 
     if (darkTheme) {
         s *= 0.84;
         v = 1;
-        if (token == QStringLiteral("ThemeColorDark1")) {
-            v *= 0.9;
-        } else if (token == QStringLiteral("ThemeColorDark2")) {
-            s *= 0.977;
-            v *= 0.82;
-        } else if (token == QStringLiteral("ThemeColorDark3")) {
-            s *= 0.95;
-            v *= 0.7;
-        } else if (token == QStringLiteral("ThemeColorLight1")) {
-            s *= 0.92;
-        } else if (token == QStringLiteral("ThemeColorLight2")) {
-            s *= 0.78;
-        } else if (token == QStringLiteral("ThemeColorLight3")) {
-            s *= 0.65;
+        switch (token) {
+            case QssTemplate::ThemeColorDark1:
+                v *= 0.9;
+                break;
+            case QssTemplate::ThemeColorDark2:
+                s *= 0.977;
+                v *= 0.82;
+                break;
+            case QssTemplate::ThemeColorDark3:
+                s *= 0.95;
+                v *= 0.7;
+                break;
+            case QssTemplate::ThemeColorLight1:
+                s *= 0.92;
+                break;
+            case QssTemplate::ThemeColorLight2:
+                s *= 0.78;
+                break;
+            case QssTemplate::ThemeColorLight3:
+                s *= 0.65;
+                break;
+            default:
+                break;
         }
     } else {
-        if (token == QStringLiteral("ThemeColorDark1")) {
-            v *= 0.75;
-        } else if (token == QStringLiteral("ThemeColorDark2")) {
-            s *= 1.05;
-            v *= 0.5;
-        } else if (token == QStringLiteral("ThemeColorDark3")) {
-            s *= 1.1;
-            v *= 0.4;
-        } else if (token == QStringLiteral("ThemeColorLight1")) {
-            v *= 1.05;
-        } else if (token == QStringLiteral("ThemeColorLight2")) {
-            s *= 0.75;
-            v *= 1.05;
-        } else if (token == QStringLiteral("ThemeColorLight3")) {
-            s *= 0.65;
-            v *= 1.05;
+        switch (token) {
+            case QssTemplate::ThemeColorDark1:
+                v *= 0.75;
+                break;
+            case QssTemplate::ThemeColorDark2:
+                s *= 1.05;
+                v *= 0.5;
+                break;
+            case QssTemplate::ThemeColorDark3:
+                s *= 1.1;
+                v *= 0.4;
+                break;
+            case QssTemplate::ThemeColorLight1:
+                v *= 1.05;
+                break;
+            case QssTemplate::ThemeColorLight2:
+                s *= 0.75;
+                v *= 1.05;
+                break;
+            case QssTemplate::ThemeColorLight3:
+                s *= 0.65;
+                v *= 1.05;
+                break;
+            default:
+                break;
         }
     }
 
@@ -496,165 +688,83 @@ static QColor themedColor(const QColor& base, bool darkTheme, const QString& tok
                             std::min(v, static_cast<QColor_HsvF_type>(1.0f)), a);
 }
 
-static QString applyThemeColorTokens(const QString& qss) {
+// Token substitutions for the current theme color and dark/light state, recomputed only
+// when either of them changes.
+static const QssTemplate::TokenValues& themeTokenValues() {
+    static QssTemplate::TokenValues values;
+    static QRgb cachedRgba = 0;
+    static int cachedDark = -1;
+
     const QColor base = QConfig::instance().themeColor();
-    const bool dark = isDarkTheme();
-
-    QString result = qss;
-    result.replace(QStringLiteral("--FontFamilies"),
-                   QStringLiteral("'Segoe UI','Microsoft YaHei','PingFang SC'"));
-
-    result.replace(QStringLiteral("--ThemeColorPrimary"), base.name());
-    result.replace(QStringLiteral("--ThemeColorDark1"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorDark1")).name());
-    result.replace(QStringLiteral("--ThemeColorDark2"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorDark2")).name());
-    result.replace(QStringLiteral("--ThemeColorDark3"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorDark3")).name());
-    result.replace(QStringLiteral("--ThemeColorLight1"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorLight1")).name());
-    result.replace(QStringLiteral("--ThemeColorLight2"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorLight2")).name());
-    result.replace(QStringLiteral("--ThemeColorLight3"),
-                   themedColor(base, dark, QStringLiteral("ThemeColorLight3")).name());
+    const int dark = isDarkTheme() ? 1 : 0;
+    if (dark == cachedDark && base.rgba() == cachedRgba) {
+        return values;
+    }
 
-    return result;
+    cachedDark = dark;
+    cachedRgba = base.rgba();
+
+    values[QssTemplate::FontFamilies] =
+        QStringLiteral("'Segoe UI','Microsoft YaHei','PingFang SC'");
+    values[QssTemplate::ThemeColorPrimary] = base.name();
+    for (int t = QssTemplate::ThemeColorDark1; t <= QssTemplate::ThemeColorLight3; ++t) {
+        values[t] = themedColor(base, dark, static_cast<QssTemplate::Token>(t)).name();
+    }
+    return values;
 }
 
-static QString fixTypeSelectors(const QString& qss) {
-    QString result = qss;
-
-    // Generic qssClass replacements: ClassName -> *[qssClass="ClassName"]
-    static const QStringList qssClassTypes = {
-        QStringLiteral("LineEdit"),
-        QStringLiteral("TextEdit"),
-        QStringLiteral("PlainTextEdit"),
-        QStringLiteral("TextBrowser"),
-        QStringLiteral("InfoBadge"),
-        QStringLiteral("PrimaryPushButton"),
-        QStringLiteral("PrimaryToolButton"),
-        QStringLiteral("PrimaryDropDownPushButton"),
-        QStringLiteral("PrimaryDropDownToolButton"),
-        QStringLiteral("TransparentPushButton"),
-        QStringLiteral("TransparentToolButton"),
-        QStringLiteral("TransparentTogglePushButton"),
-        QStringLiteral("TransparentToggleToolButton"),
-        QStringLiteral("TransparentDropDownPushButton"),
-        QStringLiteral("TransparentDropDownToolButton"),
-        QStringLiteral("ToggleButton"),
-        QStringLiteral("ToggleToolButton"),
-        QStringLiteral("TogglePushButton"),
-        QStringLiteral("DropDownPushButton"),
-        QStringLiteral("DropDownToolButton"),
-        QStringLiteral("HyperlinkButton"),
-        QStringLiteral("HyperlinkLabel"),
-        QStringLiteral("ToolButton"),
-        QStringLiteral("RadioButton"),
-        QStringLiteral("PillPushButton"),
-        QStringLiteral("PillToolButton"),
-        QStringLiteral("SplitDropButton"),
-        QStringLiteral("PrimarySplitDropButton"),
-        QStringLiteral("PushButton"),
-        QStringLiteral("TabBar"),
-        QStringLiteral("SimpleCardWidget"),
-        QStringLiteral("ElevatedCardWidget"),
-        QStringLiteral("HeaderCardWidget"),
-        QStringLiteral("GroupHeaderCardWidget"),
-        QStringLiteral("StateToolTip"),
-        QStringLiteral("ToastToolTip"),
-        QStringLiteral("SpinBox"),
-        QStringLiteral("DoubleSpinBox"),
-        QStringLiteral("CompactSpinBox"),
-        QStringLiteral("CompactDoubleSpinBox"),
-        QStringLiteral("SpinButton"),
-        QStringLiteral("DateEdit"),
-        QStringLiteral("DateTimeEdit"),
-        QStringLiteral("TimeEdit"),
-        QStringLiteral("PivotItem"),
-        QStringLiteral("Pivot"),
-        QStringLiteral("SegmentedItem"),
-        QStringLiteral("SegmentedToolItem"),
-        QStringLiteral("SegmentedWidget"),
-        QStringLiteral("SegmentedToolWidget"),
-        QStringLiteral("SegmentedToggleToolItem"),
-        QStringLiteral("SegmentedToggleToolWidget"),
-        QStringLiteral("ScrollButton"),
-        QStringLiteral("CalendarPicker"),
-        QStringLiteral("CalendarViewBase"),
-        QStringLiteral("ScrollViewBase"),
-        QStringLiteral("CycleListWidget"),
-        QStringLiteral("PickerPanel"),
-        QStringLiteral("SeparatorWidget"),
-        QStringLiteral("ItemMaskWidget"),
-        QStringLiteral("PickerBase"),
-        QStringLiteral("DatePicker"),
-        QStringLiteral("ZhDatePicker"),
-        QStringLiteral("SettingCard"),
-        QStringLiteral("SwitchSettingCard"),
-        QStringLiteral("RangeSettingCard"),
-        QStringLiteral("PushSettingCard"),
-        QStringLiteral("PrimaryPushSettingCard"),
-        QStringLiteral("HyperlinkCard"),
-        QStringLiteral("ColorPickerButton"),
-        QStringLiteral("ColorSettingCard"),
-        QStringLiteral("ComboBoxSettingCard"),
-        QStringLiteral("SettingCardGroup"),
-        QStringLiteral("ExpandSettingCard"),
-        QStringLiteral("ExpandGroupSettingCard"),
-        QStringLiteral("SimpleExpandGroupSettingCard"),
-        QStringLiteral("CustomColorSettingCard"),
-        QStringLiteral("OptionsSettingCard"),
-        QStringLiteral("FolderListSettingCard"),
-        QStringLiteral("StackedWidget"),
-        // Title bar types - need qssClass because metaObject className includes namespace prefix
-        QStringLiteral("FluentTitleBar"),
-        QStringLiteral("SplitTitleBar"),
-        QStringLiteral("MSFluentTitleBar"),
-        // Label types - need qssClass for type selector matching
-        QStringLiteral("FluentLabelBase"),
-        QStringLiteral("CaptionLabel"),
-        QStringLiteral("BodyLabel"),
-        QStringLiteral("StrongBodyLabel"),
-        QStringLiteral("SubtitleLabel"),
-        QStringLiteral("TitleLabel"),
-        QStringLiteral("LargeTitleLabel"),
-        QStringLiteral("DisplayLabel"),
-    };
+// Templates of the bundled sheets precompiled at build time, keyed by resource path.
+static const QHash<QString, QssTemplate>& precompiledQssTemplates(size_t* signature) {
+    static size_t sig = 0;
+    static const QHash<QString, QssTemplate> templates = [] {
+        QHash<QString, QssTemplate> t;
+#ifdef QFW_PRECOMPILED_QSS
+        if (!readQssTemplateBundle(precompiledQssBlob(), &t, &sig)) {
+            qWarning() << "[qfw][qss] ignoring corrupt precompiled qss bundle";
+            t.clear();
+        }
+#endif
+        return t;
+    }();
+    *signature = sig;
+    return templates;
+}
 
-    QSet<QString> allTypes;
-    for (const QString& t : qssClassTypes) {
-        allTypes.insert(t);
+static QSharedPointer<const QssTemplate> qssTemplateForPath(const QString& path) {
+    const auto it = qssTemplateCache().constFind(path);
+    if (it != qssTemplateCache().constEnd()) {
+        return it.value();
     }
-    allTypes.unite(externalQssClassTypes());
 
-    for (const QString& type : std::as_const(allTypes)) {
-        if (!result.contains(type)) {
-            continue;
-        }
-        // Avoid replacing inside existing qssClass attribute values, e.g.
-        // *[qssClass="SettingInterface"]  (otherwise we'd produce invalid nested selectors)
-        auto it = typeSelectorRegexCache().constFind(type);
-        if (it == typeSelectorRegexCache().constEnd()) {
-            it = typeSelectorRegexCache().insert(
-                type, QRegularExpression(QStringLiteral("(?<!qssClass=\")\\b") + type +
-                                         QStringLiteral("\\b")));
-        }
-        result.replace(it.value(), QStringLiteral("*[qssClass=\"") + type + QStringLiteral("\"]"));
-    }
-
-    // Special replacements with custom selectors
-    result.replace(QRegularExpression(QStringLiteral("\\bRoundMenu\\b")),
-                   QStringLiteral("QMenu[qssClass=\"RoundMenu\"]"));
-    result.replace(QRegularExpression(QStringLiteral("\\bMenuActionListWidget\\b")),
-                   QStringLiteral("QListWidget[qssClass=\"MenuActionListWidget\"]"));
-    result.replace(QRegularExpression(QStringLiteral("\\bComboBox\\b")),
-                   QStringLiteral("*[comboBox=true]"));
-    result.replace(QRegularExpression(QStringLiteral("\\bModelComboBox\\b")),
-                   QStringLiteral("*[modelComboBox=true]"));
-    result.replace(QRegularExpression(QStringLiteral("\\bInfoBar\\b")),
-                   QStringLiteral("*[infoBar=true]"));
+    size_t signature = 0;
+    const auto& precompiled = precompiledQssTemplates(&signature);
+    const auto pre = precompiled.constFind(path);
+
+    // Selector rewrites do not depend on theme or color, so they are baked into the template.
+    // A precompiled template only lacks the types registered at runtime; rewriting it again
+    // is safe because already rewritten names sit inside qssClass="..." values.
+    QSharedPointer<const QssTemplate> tmpl;
+    if (pre != precompiled.constEnd() && signature == typeSelectorRewriter().signature()) {
+        tmpl.reset(new QssTemplate(pre.value()));
+    } else if (pre != precompiled.constEnd()) {
+        tmpl.reset(new QssTemplate(QssTemplate::compile(fixTypeSelectors(pre->source()))));
+    } else {
+        tmpl.reset(new QssTemplate(QssTemplate::compile(fixTypeSelectors(readAllText(path)))));
+    }
+    qssTemplateCache().insert(path, tmpl);
 
-    return result;
+    if (qssDebugEnabled()) {
+        qssPerfStats().templateCompiled++;
+    }
+    return tmpl;
+}
+
+static QString renderQss(const QString& qss) {
+    return QssTemplate::compile(fixTypeSelectors(qss)).render(themeTokenValues());
+}
+
+static QString fixTypeSelectors(const QString& qss) {
+    return typeSelectorRewriter().rewrite(qss);
 }
 
 static QString resolveThemeQssPath(const QString& sourcePath) {
@@ -669,6 +779,181 @@ static QString resolveThemeQssPath(const QString& sourcePath) {
     return QStringLiteral(":/qfluentwidgets/qss/") + folder + QStringLiteral("/") + rest;
 }
 
+// Rendered sheets for one (versions, theme, color, class types) key, persisted as
+// <dir>/qss-<hash>.cache. Only one key is resident; switching keys flushes the old file.
+struct QssDiskCache {
+    struct Entry {
+        quint64 sourceStamp = 0;
+        QString rendered;
+    };
+
+    bool enabled = false;
+    QString directory;
+    QString key;
+    QString filePath;
+    QHash<QString, Entry> entries;
+    bool dirty = false;
+};
+
+static QssDiskCache& qssDiskCache() {
+    static QssDiskCache c;
+    return c;
+}
+
+static const quint32 kQssDiskCacheMagic = 0x51465153;  // "QFQS"
+static const quint32 kQssDiskCacheFormat = 2;
+
+static void flushQssDiskCache() {
+    QssDiskCache& c = qssDiskCache();
+    if (!c.dirty || c.filePath.isEmpty()) {
+        return;
+    }
+    c.dirty = false;
+
+    QDir().mkpath(c.directory);
+    QSaveFile f(c.filePath);
+    if (!f.open(QIODevice::WriteOnly)) {
+        qWarning() << "Failed to write qss cache:" << c.filePath << f.errorString();
+        return;
+    }
+
+    QDataStream out(&f);
+    out << kQssDiskCacheMagic << kQssDiskCacheFormat << c.key
+        << static_cast<quint32>(c.entries.size());
+    for (auto it = c.entries.constBegin(); it != c.entries.constEnd(); ++it) {
+        out << it.key() << it->sourceStamp << it->rendered;
+    }
+    if (out.status() != QDataStream::Ok || !f.commit()) {
+        qWarning() << "Failed to write qss cache:" << c.filePath;
+    }
+}
+
+static void loadQssDiskCache() {
+    QssDiskCache& c = qssDiskCache();
+    QFile f(c.filePath);
+    if (!f.open(QIODevice::ReadOnly) || f.size() <= 0) {
+        return;
+    }
+
+    // Map the file instead of reading it; the strings are decoded straight from the mapping.
+    QByteArray data;
+    uchar* mapped = f.map(0, f.size());
+    if (mapped) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                       static_cast<int>(f.size()));
+    } else {
+        data = f.readAll();
+    }
+
+    QDataStream in(data);
+    quint32 magic = 0, format = 0, count = 0;
+    QString key;
+    in >> magic >> format >> key >> count;
+    if (magic == kQssDiskCacheMagic && format == kQssDiskCacheFormat && key == c.key) {
+        for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+            QString path;
+            QssDiskCache::Entry entry;
+            in >> path >> entry.sourceStamp >> entry.rendered;
+            if (in.status() == QDataStream::Ok) {
+                c.entries.insert(path, entry);
+            }
+        }
+    }
+
+    data.clear();
+    if (mapped) {
+        f.unmap(mapped);
+    }
+}
+
+// Makes the resident entries match the current theme state; returns false if disabled.
+static bool ensureQssDiskCache() {
+    QssDiskCache& c = qssDiskCache();
+    if (!c.enabled) {
+        return false;
+    }
+
+    // QFW_QSS_HASH is a build-time hash of the bundled sheets, so edited resources don't need
+    // a version bump to invalidate the cache.
+    const QString key = QStringLiteral(QFW_VERSION "|" QFW_QSS_HASH "|" QT_VERSION_STR "|") +
+                        QCoreApplication::applicationVersion() + QLatin1Char('|') +
+                        themeFolder(Theme::Auto) + QLatin1Char('|') +
+                        QConfig::instance().themeColor().name(QColor::HexArgb) + QLatin1Char('|') +
+                        QString::number(static_cast<quint64>(typeSelectorRewriter().signature()));
+    if (key == c.key) {
+        return true;
+    }
+
+    flushQssDiskCache();
+    c.entries.clear();
+    c.key = key;
+    c.filePath = c.directory + QStringLiteral("/qss-") +
+                 QString::number(static_cast<quint64>(qHash(key)), 16) + QStringLiteral(".cache");
+    loadQssDiskCache();
+    return true;
+}
+
+void setQssDiskCacheEnabled(bool enabled, const QString& directory) {
+    QssDiskCache& c = qssDiskCache();
+    if (!enabled) {
+        flushQssDiskCache();
+        c = QssDiskCache();
+        return;
+    }
+
+    const QString dir = directory.isEmpty()
+                            ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) +
+                                  QStringLiteral("/qfluentwidgets")
+                            : directory;
+    if (c.enabled && c.directory == dir) {
+        return;
+    }
+
+    flushQssDiskCache();
+    c = QssDiskCache();
+    c.enabled = true;
+    c.directory = dir;
+
+    static bool hooked = false;
+    if (!hooked && QCoreApplication::instance()) {
+        hooked = true;
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         &flushQssDiskCache);
+    }
+}
+
+// Resources are covered by the cache key (library build hash, application version); files on
+// disk are checked by modification time and size, without reading them.
+static quint64 qssSourceStamp(const QString& path) {
+    if (path.startsWith(QLatin1Char(':'))) {
+        return 0;
+    }
+    const QFileInfo info(path);
+    return static_cast<quint64>(info.lastModified().toMSecsSinceEpoch()) ^
+           (static_cast<quint64>(info.size()) << 44);
+}
+
+static QString renderBundledQss(const QString& themedPath) {
+    if (!ensureQssDiskCache()) {
+        return qssTemplateForPath(themedPath)->render(themeTokenValues());
+    }
+
+    const quint64 sourceStamp = qssSourceStamp(themedPath);
+    QssDiskCache& c = qssDiskCache();
+    const auto it = c.entries.constFind(themedPath);
+    if (it != c.entries.constEnd() && it->sourceStamp == sourceStamp) {
+        if (qssDebugEnabled()) {
+            qssPerfStats().diskCacheHit++;
+        }
+        return it->rendered;
+    }
+
+    const QString rendered = qssTemplateForPath(themedPath)->render(themeTokenValues());
+    c.entries.insert(themedPath, {sourceStamp, rendered});
+    c.dirty = true;
+    return rendered;
+}
+
 QString getStyleSheet(const QString& sourcePath, Theme theme) {
     const QString themedPath = resolveThemeQssPath(sourcePath);
     Q_UNUSED(theme);
@@ -692,8 +977,7 @@ QString getStyleSheet(const QString& sourcePath, Theme theme) {
         qssPerfStats().renderedCacheMiss++;
     }
 
-    const QString qss = readAllText(themedPath);
-    const QString rendered = fixTypeSelectors(applyThemeColorTokens(qss));
+    const QString rendered = renderBundledQss(themedPath);
     renderedQssCache().insert(cacheKey, rendered);
 
     if (qssDebugEnabled()) {
@@ -706,6 +990,12 @@ QString getStyleSheet(FluentStyleSheet sheet, Theme theme) {
     return getStyleSheet(styleSheetPath(sheet, theme), theme);
 }
 
+static bool applySharedIfScoped(QWidget* widget, Theme theme) {
+    auto& manager = StyleSheetManager::instance();
+    const auto source = manager.source(widget);
+    return source && manager.applySharedStyleSheet(widget, *source, theme);
+}
+
 void setStyleSheet(QWidget* widget, const QString& sourcePath, Theme theme, bool registerWidget) {
     if (!widget) {
         return;
@@ -713,6 +1003,9 @@ void setStyleSheet(QWidget* widget, const QString& sourcePath, Theme theme, bool
 
     if (registerWidget) {
         StyleSheetManager::instance().registerWidget(widget, sourcePath, true);
+        if (applySharedIfScoped(widget, theme)) {
+            return;
+        }
     }
 
 #ifndef NDEBUG
@@ -731,6 +1024,9 @@ void setStyleSheet(QWidget* widget, FluentStyleSheet sheet, Theme theme, bool re
     if (registerWidget) {
         StyleSheetManager::instance().registerWidget(
             widget, QSharedPointer<StyleSheetBase>(new FluentStyleSheetSource(sheet)), true);
+        if (applySharedIfScoped(widget, theme)) {
+            return;
+        }
     }
 
 #ifndef NDEBUG
@@ -758,11 +1054,18 @@ void setStyleSheet(QWidget* widget, const StyleSheetBase& source, Theme theme,
             StyleSheetManager::instance().registerWidget(
                 widget, QSharedPointer<StyleSheetBase>(new CustomStyleSheet(widget)), true);
         }
+        if (applySharedIfScoped(widget, theme)) {
+            return;
+        }
     }
 
     setStyleSheetIfChanged(widget, getStyleSheet(source, theme));
 }
 
+void setStyleSheetSharingEnabled(QWidget* scope, bool enabled) {
+    StyleSheetManager::instance().setSharingScope(scope, enabled);
+}
+
 void setCustomStyleSheet(QWidget* widget, const QString& lightQss, const QString& darkQss) {
     CustomStyleSheet(widget).setCustomStyleSheet(lightQss, darkQss);
 }
@@ -812,11 +1115,18 @@ StyleSheetManager& StyleSheetManager::instance() {
 }
 
 StyleSheetManager::StyleSheetManager(QObject* parent) : QObject(parent) {
+    sliceTimer_.setInterval(0);
+    QObject::connect(&sliceTimer_, &QTimer::timeout, this, &StyleSheetManager::processUpdateSlice);
+
     QObject::connect(&QConfig::instance(), &QConfig::themeChanged, this, [this](Theme theme) {
         const bool lazy = nextLazyUpdate_;
         qInfo().noquote() << "[qfw][theme] themeChanged signal received, theme=" << static_cast<int>(theme)
                           << "lazy=" << lazy << "items_.size()=" << items_.size();
         nextLazyUpdate_ = false;
+        if (timeSliceMs_ > 0) {
+            scheduleStyleSheetUpdate(lazy, true);
+            return;
+        }
         updateStyleSheet(lazy);
         QConfig::instance().notifyThemeChangedFinished();
     });
@@ -827,6 +1137,10 @@ StyleSheetManager::StyleSheetManager(QObject* parent) : QObject(parent) {
             qInfo().noquote() << "[qfw][theme] themeColorChanged signal received, nextLazyUpdate_="
                               << lazy << "items_.size()=" << items_.size();
             nextLazyUpdate_ = false;
+            if (timeSliceMs_ > 0) {
+                scheduleStyleSheetUpdate(lazy, false);
+                return;
+            }
             updateStyleSheet(lazy);
         });
 }
@@ -855,27 +1169,28 @@ void StyleSheetManager::registerWidget(QWidget* widget,
 
     ensureWatchersInstalled(widget);
 
-    for (auto& item : items_) {
-        if (item.widget == widget) {
-            if (!item.source) {
-                item.source = QSharedPointer<StyleSheetCompose>(new StyleSheetCompose(
-                    {source, QSharedPointer<StyleSheetBase>(new CustomStyleSheet(widget))}));
-            } else if (reset) {
-                item.source = QSharedPointer<StyleSheetCompose>(new StyleSheetCompose(
-                    {source, QSharedPointer<StyleSheetBase>(new CustomStyleSheet(widget))}));
-            } else {
-                item.source->add(source);
-            }
-            return;
+    const auto it = index_.constFind(widget);
+    if (it != index_.constEnd()) {
+        Item& item = items_[it.value()];
+        if (!item.source || reset) {
+            item.source = QSharedPointer<StyleSheetCompose>(new StyleSheetCompose(
+                {source, QSharedPointer<StyleSheetBase>(new CustomStyleSheet(widget))}));
+        } else {
+            item.source->add(source);
         }
+        return;
     }
 
     Item item;
+    item.key = widget;
     item.widget = widget;
     item.source = QSharedPointer<StyleSheetCompose>(new StyleSheetCompose(
         {source, QSharedPointer<StyleSheetBase>(new CustomStyleSheet(widget))}));
+    index_.insert(widget, items_.size());
     items_.append(item);
 
+    // The QPointer in the entry may already be cleared when destroyed() fires, so the
+    // raw pointer captured here is what identifies the entry.
     QObject::connect(widget, &QObject::destroyed, this,
                      [this, widget]() { deregisterWidget(widget); });
 }
@@ -885,60 +1200,657 @@ void StyleSheetManager::deregisterWidget(QWidget* widget) {
         return;
     }
 
-    for (int i = items_.size() - 1; i >= 0; --i) {
-        if (items_[i].widget == widget) {
-            items_.removeAt(i);
+    const auto it = index_.constFind(widget);
+    if (it != index_.constEnd()) {
+        removeAt(it.value());
+    }
+}
+
+void StyleSheetManager::removeAt(int index) {
+    Item& item = items_[index];
+    if (!item.key) {
+        return;
+    }
+
+    index_.remove(item.key);
+    item.key = nullptr;
+    item.widget.clear();
+    item.source.reset();
+    ++tombstones_;
+
+    // Keep removal amortized O(1): only squeeze the list once it is mostly tombstones, and
+    // never while updateStyleSheet() is walking it by index.
+    if (!updating_ && tombstones_ > 64 && tombstones_ * 2 > items_.size()) {
+        compact();
+    }
+}
+
+void StyleSheetManager::compact() {
+    QList<Item> alive;
+    alive.reserve(items_.size() - tombstones_);
+    for (const Item& item : std::as_const(items_)) {
+        if (item.key) {
+            alive.append(item);
         }
     }
+
+    items_ = std::move(alive);
+    tombstones_ = 0;
+    ++compactions_;
+
+    index_.clear();
+    index_.reserve(items_.size());
+    for (int i = 0; i < items_.size(); ++i) {
+        index_.insert(items_[i].key, i);
+    }
 }
 
 QSharedPointer<StyleSheetCompose> StyleSheetManager::source(QWidget* widget) const {
     if (!widget) {
         return {};
     }
-    for (const auto& item : items_) {
-        if (item.widget == widget) {
-            return item.source;
+    const auto it = index_.constFind(widget);
+    return it != index_.constEnd() ? items_[it.value()].source : QSharedPointer<StyleSheetCompose>();
+}
+
+StyleSheetRegistryStats StyleSheetManager::registryStats() const {
+    StyleSheetRegistryStats stats;
+    stats.entries = static_cast<int>(items_.size());
+    stats.tombstones = tombstones_;
+    stats.compactions = compactions_;
+    return stats;
+}
+
+bool StyleSheetManager::applyStyleSheet(QWidget* widget, const QString& qss) {
+    if (!widget) {
+        return false;
+    }
+
+    QElapsedTimer timer;
+    if (qssDebugEnabled()) {
+        timer.start();
+    }
+
+    const size_t hash = qssContentHash(qss);
+    const auto it = index_.constFind(widget);
+    const Item* item = (it != index_.constEnd()) ? &items_[it.value()] : nullptr;
+
+    // A differing hash proves the sheet changed. Only on a match (or when nothing is known
+    // about the widget) read back the current sheet, which may have been set behind our back.
+    bool same = false;
+    if (!item || !item->hashValid || item->appliedHash == hash) {
+        const QString current = widget->styleSheet();
+        if (qssDebugEnabled()) {
+            qssPerfStats().getWidgetStyleMs += timer.elapsed();
+            timer.restart();
+        }
+
+        same = (current.constData() == qss.constData() && current.size() == qss.size()) ||
+               current == qss;
+        if (qssDebugEnabled()) {
+            qssPerfStats().compareMs += timer.elapsed();
+            timer.restart();
+            if (!same && item && item->hashValid) {
+                qssPerfStats().hashCollisions++;
+            }
+        }
+    }
+
+    if (!same) {
+        widget->setStyleSheet(qss);
+        if (qssDebugEnabled()) {
+            qssPerfStats().setStyleMs += timer.elapsed();
+            qssPerfStats().widgetsApplied++;
+        }
+    } else if (qssDebugEnabled()) {
+        qssPerfStats().widgetsApplySkipped++;
+    }
+
+    // setStyleSheet() may have registered other widgets, so look the entry up again.
+    const auto entry = index_.constFind(widget);
+    if (entry != index_.constEnd()) {
+        items_[entry.value()].appliedHash = hash;
+        items_[entry.value()].hashValid = true;
+    }
+    return !same;
+}
+
+void StyleSheetManager::setSharingScope(QWidget* scope, bool enabled) {
+    if (!scope || scopes_.contains(scope) == enabled) {
+        return;
+    }
+
+    if (enabled) {
+        SharedScope& st = scopes_[scope];
+        st.destroyedConnection = QObject::connect(scope, &QObject::destroyed, this,
+                                                  [this, scope]() { scopes_.remove(scope); });
+    } else {
+        QObject::disconnect(scopes_.value(scope).destroyedConnection);
+        scopes_.remove(scope);
+
+        const auto s = source(scope);
+        applyStyleSheet(scope, s ? s->styleSheet(Theme::Auto) : QString());
+    }
+
+    // Move the bundled sheets of the subtree onto (or back off) the scope.
+    updateStyleSheet(false);
+}
+
+bool StyleSheetManager::hasSharingScopes() const { return !scopes_.isEmpty(); }
+
+QWidget* StyleSheetManager::sharingScopeFor(QWidget* widget) const {
+    if (scopes_.isEmpty()) {
+        return nullptr;
+    }
+    for (QWidget* p = widget->parentWidget(); p; p = p->parentWidget()) {
+        if (scopes_.contains(p)) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+// Whether the leading compound of a selector names a library class: one carrying a
+// [qssClass="X"] attribute from the rewriter, or a type name that isn't a Qt class.
+static bool isLibraryClassCompound(QStringView selector) {
+    int end = 0;
+    int brackets = 0;
+    for (; end < selector.size(); ++end) {
+        const QChar c = selector.at(end);
+        if (c == QLatin1Char('[')) {
+            ++brackets;
+        } else if (c == QLatin1Char(']')) {
+            --brackets;
+        } else if (brackets == 0 && (c.isSpace() || c == QLatin1Char('>') ||
+                                     c == QLatin1Char('+') || c == QLatin1Char('~'))) {
+            break;
+        }
+    }
+    if (selector.left(end).contains(QLatin1String("[qssClass="))) {
+        return true;
+    }
+    if (selector.isEmpty() || !selector.at(0).isLetter()) {
+        return false;  // #id, .Class, *, :pseudo
+    }
+    return !(selector.size() > 1 && selector.at(0) == QLatin1Char('Q') && selector.at(1).isUpper());
+}
+
+// Restricts |selector| to the widgets carrying the hoisted sheet (|attr|) and their
+// descendants, which is what it matched while the sheet sat on each of those widgets.
+static QString scopeSelector(QStringView selector, const QString& attr) {
+    QString self;
+    if (selector.at(0).isLetter()) {
+        int n = 1;
+        while (n < selector.size() &&
+               (selector.at(n).isLetterOrNumber() || selector.at(n) == QLatin1Char('_'))) {
+            ++n;
+        }
+        self = selector.left(n).toString() + attr + selector.mid(n).toString();
+    } else if (selector.at(0) == QLatin1Char('*')) {
+        self = QLatin1Char('*') + attr + selector.mid(1).toString();
+    } else {
+        self = QLatin1Char('*') + attr + selector.toString();
+    }
+    return self + QStringLiteral(", *") + attr + QLatin1Char(' ') + selector.toString();
+}
+
+// Rewrites |qss| so it can sit on a sharing scope: selectors that start from a library class
+// are kept, the others are restricted to widgets whose qssShared list contains |id|.
+static QString scopeSheet(const QString& qss, const QString& id) {
+    const QString attr = QStringLiteral("[qssShared~=\"") + id + QStringLiteral("\"]");
+    QString out;
+    out.reserve(qss.size());
+    int selectorStart = 0;
+    int depth = 0;      // inside a rule body
+    int brackets = 0;   // inside [attr=...] of a selector
+    QChar quote;
+    for (int i = 0; i < qss.size(); ++i) {
+        const QChar c = qss.at(i);
+        if (!quote.isNull()) {
+            if (c == quote) {
+                quote = QChar();
+            }
+            if (depth > 0) {
+                out.append(c);
+            }
+            continue;
+        }
+        if (c == QLatin1Char('/') && i + 1 < qss.size() && qss.at(i + 1) == QLatin1Char('*')) {
+            const int end = qss.indexOf(QLatin1String("*/"), i + 2);
+            i = end < 0 ? static_cast<int>(qss.size()) : end + 1;
+            if (depth == 0) {
+                selectorStart = i + 1;
+            }
+            continue;
+        }
+        if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            quote = c;
+        }
+
+        if (depth > 0) {
+            out.append(c);
+            if (c == QLatin1Char('}')) {
+                --depth;
+                selectorStart = i + 1;
+            } else if (c == QLatin1Char('{')) {
+                ++depth;
+            }
+            continue;
+        }
+
+        if (c == QLatin1Char('[')) {
+            ++brackets;
+        } else if (c == QLatin1Char(']')) {
+            brackets = qMax(0, brackets - 1);
+        } else if (brackets == 0 && (c == QLatin1Char(',') || c == QLatin1Char('{'))) {
+            const QStringView selector =
+                QStringView(qss).mid(selectorStart, i - selectorStart).trimmed();
+            if (selector.isEmpty() || isLibraryClassCompound(selector)) {
+                out.append(selector);
+            } else {
+                out.append(scopeSelector(selector, attr));
+            }
+            out.append(c);
+            selectorStart = i + 1;
+            if (c == QLatin1Char('{')) {
+                depth = 1;
+            }
+        }
+    }
+    return out;
+}
+
+// Short ids for hoisted sheets, stable across themes so qssShared doesn't grow on a switch.
+static QString sharedSheetId(const StyleSheetBase& source) {
+    if (const auto* fluent = dynamic_cast<const FluentStyleSheetSource*>(&source)) {
+        return sheetName(fluent->sheet());
+    }
+    const auto* file = dynamic_cast<const StyleSheetFile*>(&source);
+    if (!file) {
+        return QString();
+    }
+
+    static QHash<QString, QString> ids;
+    auto it = ids.find(file->path());
+    if (it == ids.end()) {
+        it = ids.insert(file->path(), QStringLiteral("file") + QString::number(ids.size()));
+    }
+    return it.value();
+}
+
+static QString sharedSheetPath(const StyleSheetBase& source, Theme theme) {
+    if (const auto* fluent = dynamic_cast<const FluentStyleSheetSource*>(&source)) {
+        return styleSheetPath(fluent->sheet(), theme);
+    }
+    return static_cast<const StyleSheetFile&>(source).path();
+}
+
+static void splitSharedParts(const StyleSheetCompose& compose, Theme theme, QStringList* shared,
+                             QStringList* sharedIds, QString* own) {
+    for (const auto& s : compose.sources()) {
+        if (!s) {
+            continue;
+        }
+        const QString part = getStyleSheet(*s, theme);
+        if (part.isEmpty()) {
+            continue;
+        }
+
+        // Bundled and file sheets are the same for every widget using them; custom QSS and
+        // user sources stay on the widget.
+        const QString id = sharedSheetId(*s);
+        if (id.isEmpty()) {
+            if (!own->isEmpty()) {
+                *own += QLatin1Char('\n');
+            }
+            *own += part;
+            continue;
+        }
+
+        const QString key =
+            renderedCacheKeyForPath(resolveThemeQssPath(sharedSheetPath(*s, theme)));
+        auto it = sharedQssCache().find(key);
+        if (it == sharedQssCache().end()) {
+            it = sharedQssCache().insert(key, scopeSheet(part, id));
+        }
+        shared->append(it.value());
+        sharedIds->append(id);
+    }
+}
+
+bool StyleSheetManager::applySharedStyleSheet(QWidget* widget, const StyleSheetCompose& source,
+                                              Theme theme, bool applyOwn) {
+    if (!widget || scopes_.isEmpty()) {
+        return false;
+    }
+
+    // A registered scope keeps its own sheet next to the shared ones.
+    const auto self = scopes_.find(widget);
+    if (self != scopes_.end()) {
+        self->ownSheet = source.styleSheet(theme);
+        if (!updating_) {
+            flushScope(widget);
+        }
+        return true;
+    }
+
+    QWidget* scope = sharingScopeFor(widget);
+    if (!scope) {
+        return false;
+    }
+
+    QStringList shared;
+    QStringList sharedIds;
+    QString own;
+    splitSharedParts(source, theme, &shared, &sharedIds, &own);
+
+    // The hoisted rules only reach widgets marked as carrying the sheet, and their subtrees.
+    QStringList marks = widget->property("qssShared").toStringList();
+    bool marked = false;
+    for (const QString& id : std::as_const(sharedIds)) {
+        if (!marks.contains(id)) {
+            marks.append(id);
+            marked = true;
+        }
+    }
+    if (marked) {
+        widget->setProperty("qssShared", marks);
+    }
+
+    SharedScope& st = scopes_[scope];
+    bool grown = false;
+    for (const QString& part : std::as_const(shared)) {
+        if (!st.sheetSet.contains(part)) {
+            st.sheetSet.insert(part);
+            st.sheets.append(part);
+            grown = true;
         }
     }
-    return {};
+
+    // Outside a full update, a class seen for the first time re-styles the scope right away.
+    if (grown && !updating_) {
+        flushScope(scope);
+    }
+    if (applyOwn) {
+        setStyleSheetIfChanged(widget, own);
+    }
+    return true;
+}
+
+void StyleSheetManager::flushScope(QWidget* scope) {
+    const auto it = scopes_.constFind(scope);
+    if (it == scopes_.constEnd()) {
+        return;
+    }
+
+    QString qss = it->sheets.join(QLatin1Char('\n'));
+    if (!it->ownSheet.isEmpty()) {
+        if (!qss.isEmpty()) {
+            qss += QLatin1Char('\n');
+        }
+        qss += it->ownSheet;
+    }
+    applyStyleSheet(scope, qss);
 }
 
 void StyleSheetManager::setNextLazyUpdate(bool lazy) {
     nextLazyUpdate_ = lazy;
 }
 
+void StyleSheetManager::applyRegistered(QWidget* widget, const StyleSheetCompose& source) {
+    if (!applySharedStyleSheet(widget, source, Theme::Auto)) {
+        setStyleSheetIfChanged(widget, getStyleSheet(source, Theme::Auto));
+    }
+}
+
+void StyleSheetManager::setUpdateTimeSlice(int msecs) { timeSliceMs_ = std::max(0, msecs); }
+
+int StyleSheetManager::updateTimeSlice() const { return timeSliceMs_; }
+
+bool StyleSheetManager::isUpdatePending() const { return pendingPos_ < pending_.size(); }
+
+int StyleSheetManager::pendingUpdateCount() const {
+    return static_cast<int>(pending_.size()) - pendingPos_;
+}
+
+void StyleSheetManager::cancelPendingUpdate() {
+    // Scope sheets are only valid once every widget below them was collected, so a started
+    // rebuild is completed rather than leaving the scopes half-filled.
+    while (pendingPos_ < scopedPending_) {
+        processPendingAt(pendingPos_++);
+    }
+    finishScopeRebuild();
+
+    for (int i = pendingPos_; i < pending_.size(); ++i) {
+        if (QWidget* w = pending_.at(i)) {
+            w->setProperty("dirty-qss", true);
+        }
+    }
+
+    const bool notify = notifyThemeFinished_;
+    resetPendingUpdate();
+    if (notify) {
+        QConfig::instance().notifyThemeChangedFinished();
+    }
+}
+
+void StyleSheetManager::resetPendingUpdate() {
+    sliceTimer_.stop();
+    if (scopedPending_ > 0) {
+        // Superseded mid-rebuild; the caller starts a new one or finishes it itself.
+        updating_ = false;
+        scopedPending_ = 0;
+    }
+    pending_.clear();
+    pendingPos_ = 0;
+    pendingTotal_ = 0;
+    pendingDone_ = 0;
+    notifyThemeFinished_ = false;
+}
+
+void StyleSheetManager::scheduleStyleSheetUpdate(bool lazy, bool notifyThemeFinished) {
+    // A newer theme supersedes the queued work, but a pending themeChangedFinished must still
+    // be delivered once the new queue drains.
+    const bool notify = notifyThemeFinished || notifyThemeFinished_;
+    resetPendingUpdate();
+    notifyThemeFinished_ = notify;
+
+    struct Entry {
+        qint64 area;
+        QWidget* widget;
+    };
+    QVector<Entry> visible;
+    QList<QPointer<QWidget>> hidden;
+    QList<QWidget*> scoped;
+
+    for (const Item& item : std::as_const(items_)) {
+        QWidget* w = item.widget.data();
+        if (!item.key || !w || !item.source) {
+            continue;
+        }
+
+        // Widgets below sharing scopes only carry their overrides; the scope sheets are rebuilt
+        // from all of them before being applied.
+        if (!scopes_.isEmpty() && (scopes_.contains(w) || sharingScopeFor(w))) {
+            scoped.append(w);
+        } else if (w->isVisible()) {
+            const QRect r = w->visibleRegion().boundingRect();
+            visible.append(Entry{static_cast<qint64>(r.width()) * r.height(), w});
+        } else {
+            // Restyled on first paint if it is shown before its turn
+            w->setProperty("dirty-qss", true);
+            if (!lazy) {
+                hidden.append(w);
+            }
+        }
+    }
+
+    std::stable_sort(visible.begin(), visible.end(),
+                     [](const Entry& a, const Entry& b) { return a.area > b.area; });
+
+    // Scoped widgets go first: their scopes keep the previous sheets until the last of them has
+    // been collected, and are then flushed together.
+    pending_.reserve(scoped.size() + visible.size() + hidden.size());
+    for (QWidget* w : std::as_const(scoped)) {
+        pending_.append(w);
+    }
+    for (const Entry& e : std::as_const(visible)) {
+        pending_.append(e.widget);
+    }
+    pending_.append(hidden);
+    pendingTotal_ = static_cast<int>(pending_.size());
+
+    if (!scoped.isEmpty()) {
+        for (auto it = scopes_.begin(); it != scopes_.end(); ++it) {
+            it->sheets.clear();
+            it->sheetSet.clear();
+        }
+        updating_ = true;
+        scopedPending_ = static_cast<int>(scoped.size());
+    }
+
+    // The first slice runs now, so the largest visible surfaces switch without a frame delay.
+    processUpdateSlice();
+}
+
+void StyleSheetManager::processPendingAt(int index) {
+    const QPointer<QWidget> w = pending_.at(index);
+    ++pendingDone_;
+    if (!w) {
+        return;
+    }
+
+    w->setProperty("dirty-qss", false);
+    if (const auto s = source(w)) {
+        applyRegistered(w, *s);
+    }
+}
+
+void StyleSheetManager::finishScopeRebuild() {
+    if (scopedPending_ == 0) {
+        return;
+    }
+
+    updating_ = false;
+    scopedPending_ = 0;
+    const QList<QWidget*> scopes = scopes_.keys();
+    for (QWidget* scope : scopes) {
+        flushScope(scope);
+    }
+}
+
+void StyleSheetManager::processUpdateSlice() {
+    // Updates stay enabled: each restyled widget repaints itself, and disabling them on the
+    // top-level windows would force a full repaint after every slice.
+    QElapsedTimer timer;
+    timer.start();
+
+    while (pendingPos_ < pending_.size()) {
+        processPendingAt(pendingPos_++);
+        if (pendingPos_ == scopedPending_) {
+            finishScopeRebuild();
+        }
+
+        if (timer.elapsed() >= timeSliceMs_) {
+            break;
+        }
+    }
+
+    emit styleSheetUpdateProgress(pendingDone_, pendingTotal_);
+
+    if (pendingPos_ < pending_.size()) {
+        if (!sliceTimer_.isActive()) {
+            sliceTimer_.start();
+        }
+        return;
+    }
+
+    const bool notify = notifyThemeFinished_;
+    resetPendingUpdate();
+    emit styleSheetUpdateFinished();
+    if (notify) {
+        QConfig::instance().notifyThemeChangedFinished();
+    }
+}
+
 void StyleSheetManager::updateStyleSheet(bool lazy) {
+    QElapsedTimer timer;
+    if (qssDebugEnabled()) {
+        qssPerfStats() = QssPerfStats();
+        timer.start();
+    }
+
     QWidgetList topLevelWidgets = QApplication::topLevelWidgets();
     for (QWidget* w : topLevelWidgets) {
         w->setUpdatesEnabled(false);
     }
 
+    // Sharing scopes are rebuilt from the widgets below them and applied once at the end.
+    for (auto it = scopes_.begin(); it != scopes_.end(); ++it) {
+        it->sheets.clear();
+        it->sheetSet.clear();
+    }
+
+    updating_ = true;
     for (int i = items_.size() - 1; i >= 0; --i) {
-        auto& item = items_[i];
+        if (!items_[i].key) {
+            continue;
+        }
+
+        if (qssDebugEnabled()) {
+            qssPerfStats().widgetsTotal++;
+        }
 
-        if (!item.widget) {
-            items_.removeAt(i);
+        // Copy out of the entry: applying a sheet may register widgets and grow items_.
+        const QPointer<QWidget> widget = items_[i].widget;
+        const QSharedPointer<StyleSheetCompose> source = items_[i].source;
+        if (!widget) {
+            removeAt(i);
+            if (qssDebugEnabled()) {
+                qssPerfStats().widgetsDeadRemoved++;
+            }
             continue;
         }
 
         // On macOS, visibleRegion() may return empty region for frameless windows
         // Use isVisible() check instead for lazy mode
-        if (lazy && !item.widget->isVisible()) {
-            item.widget->setProperty("dirty-qss", true);
+        if (lazy && !widget->isVisible()) {
+            if (source) {
+                applySharedStyleSheet(widget, *source, Theme::Auto, false);
+            }
+            widget->setProperty("dirty-qss", true);
+            if (qssDebugEnabled()) {
+                qssPerfStats().widgetsLazySkipped++;
+            }
             continue;
         }
 
-        if (item.source) {
-            QString qss = getStyleSheet(*item.source, Theme::Auto);
-            setStyleSheetIfChanged(item.widget, qss);
+        if (source) {
+            applyRegistered(widget, *source);
+        } else if (qssDebugEnabled()) {
+            qssPerfStats().widgetsNoSource++;
         }
     }
+    updating_ = false;
+
+    const QList<QWidget*> scopes = scopes_.keys();
+    for (QWidget* scope : scopes) {
+        flushScope(scope);
+    }
+
+    if (tombstones_ > 0) {
+        compact();
+    }
 
     // 恢复重绘
     for (QWidget* w : topLevelWidgets) {
         w->setUpdatesEnabled(true);
     }
+
+    if (qssDebugEnabled()) {
+        qssPerfStats().updateMs = timer.elapsed();
+        dumpQssPerfStats();
+    }
 }
 
 void setTheme(Theme theme, bool save, bool lazy) {
@@ -987,6 +1899,9 @@ bool CustomStyleSheetWatcher::eventFilter(QObject* obj, QEvent* e) {
     const auto* de = static_cast<QDynamicPropertyChangeEvent*>(e);
     const QByteArray name = de->propertyName();
     if (name == CustomStyleSheet::LIGHT_QSS_KEY || name == CustomStyleSheet::DARK_QSS_KEY) {
+        if (auto s = StyleSheetManager::instance().source(w)) {
+            s->invalidate();
+        }
         addStyleSheet(w, CustomStyleSheet(w), Theme::Auto, true);
     }
 
@@ -995,13 +1910,28 @@ bool CustomStyleSheetWatcher::eventFilter(QObject* obj, QEvent* e) {
 
 bool DirtyStyleSheetWatcher::eventFilter(QObject* obj, QEvent* e) {
     auto* w = qobject_cast<QWidget*>(obj);
+    if (w && e->type() == QEvent::ParentChange &&
+        StyleSheetManager::instance().hasSharingScopes()) {
+        // The subtree may have moved into or out of a sharing scope; restyle it on next paint.
+        w->setProperty("dirty-qss", true);
+        const QList<QWidget*> children = w->findChildren<QWidget*>();
+        for (QWidget* child : children) {
+            if (StyleSheetManager::instance().source(child)) {
+                child->setProperty("dirty-qss", true);
+            }
+        }
+        return QObject::eventFilter(obj, e);
+    }
+
     if (!w || e->type() != QEvent::Paint || !w->property("dirty-qss").toBool()) {
         return QObject::eventFilter(obj, e);
     }
 
     w->setProperty("dirty-qss", false);
     if (auto s = StyleSheetManager::instance().source(w)) {
-        setStyleSheetIfChanged(w, getStyleSheet(*s, Theme::Auto));
+        if (!StyleSheetManager::instance().applySharedStyleSheet(w, *s, Theme::Auto)) {
+            setStyleSheetIfChanged(w, getStyleSheet(*s, Theme::Auto));
+        }
     }
 
     return QObject::eventFilter(obj, e);
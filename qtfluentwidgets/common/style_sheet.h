@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QPointer>
@@ -7,6 +8,8 @@
 #include <QSharedPointer>
 #include <QString>
 #include <QStringList>
+#include <QTimer>
+#include <memory>
 
 #include "common/config.h"
 
@@ -108,8 +111,17 @@ public:
     void add(const QSharedPointer<StyleSheetBase>& source);
     void remove(const QSharedPointer<StyleSheetBase>& source);
 
+    // Rendered QSS of all sources, memoized until the theme, theme color or registered class
+    // types change. Composes made only of bundled/file sources (plus empty custom QSS) share
+    // one rendered string, so e.g. every PushButton holds the same QString instance.
+    QString styleSheet(Theme theme = Theme::Auto) const;
+    void invalidate();
+
 private:
+    struct RenderCache;
+
     QList<QSharedPointer<StyleSheetBase>> sources_;
+    mutable std::shared_ptr<RenderCache> cache_;
 };
 
 class CustomStyleSheetWatcher final : public QObject {
@@ -146,6 +158,18 @@ void setStyleSheet(QWidget* widget, const StyleSheetBase& source, Theme theme =
 
 void setCustomStyleSheet(QWidget* widget, const QString& lightQss, const QString& darkQss);
 
+// Opt-in: registered widgets below |scope| stop receiving their bundled sheets one by one.
+// Each unique rendered sheet is applied once on |scope|, so Qt parses it once and it cascades
+// to the subtree, while widgets keep only their custom QSS as overrides. Selectors that don't
+// start from a library class (#id, bare Qt types, *) are restricted to the widgets carrying the
+// sheet, which are marked in their "qssShared" property, and to their descendants.
+//
+// Precedence changes with the move: hoisted rules now come from an ancestor, so they lose to
+// any sheet set on the widget or on a widget between it and |scope|, whatever its specificity.
+// Hoisted sheets are ordered by first use within the scope. A registered widget that is
+// reparented into or out of a scope is restyled, with its subtree, on its next paint.
+void setStyleSheetSharingEnabled(QWidget* scope, bool enabled = true);
+
 void addStyleSheet(QWidget* widget, const StyleSheetBase& source, Theme theme = Theme::Auto,
                    bool registerWidget = true);
 
@@ -158,11 +182,24 @@ void setThemeColor(const QColor& color, bool save, bool lazy);
 
 QColor themeColor();
 
+// Persists rendered sheets across launches, keyed by library/Qt/application version, a
+// build-time hash of the bundled sheets, theme, theme color and the registered class types.
+// Entries for files on disk are also checked against their modification time and size.
+// |directory| defaults to QStandardPaths::CacheLocation.
+void setQssDiskCacheEnabled(bool enabled, const QString& directory = QString());
+
 void registerQssClassType(const QString& typeName);
 void registerQssClassTypes(const QStringList& typeNames);
 
 void updateDynamicStyle(QWidget* widget);
 
+// Occupancy of the StyleSheetManager registry
+struct StyleSheetRegistryStats {
+    int entries = 0;     // registered widgets plus tombstones
+    int tombstones = 0;  // entries of destroyed or deregistered widgets not yet squeezed out
+    int compactions = 0;
+};
+
 class StyleSheetManager final : public QObject {
     Q_OBJECT
 
@@ -175,21 +212,95 @@ public:
     void deregisterWidget(QWidget* widget);
 
     QSharedPointer<StyleSheetCompose> source(QWidget* widget) const;
+    StyleSheetRegistryStats registryStats() const;
     void setNextLazyUpdate(bool lazy);
 
+    // Calls widget->setStyleSheet(qss) unless the widget already holds qss. For registered
+    // widgets the last applied content hash is remembered, so a changed sheet is detected
+    // without reading back and comparing the widget's current style sheet.
+    bool applyStyleSheet(QWidget* widget, const QString& qss);
+
+    void setSharingScope(QWidget* scope, bool enabled);
+    bool hasSharingScopes() const;
+
+    // Applies |source| through the widget's sharing scope; returns false if it has none.
+    // With applyOwn == false only the shared part is collected (used for lazily skipped widgets).
+    bool applySharedStyleSheet(QWidget* widget, const StyleSheetCompose& source,
+                               Theme theme = Theme::Auto, bool applyOwn = true);
+
+    // Time budget per event-loop turn for theme switches. With 0 (the default) every widget is
+    // updated synchronously; otherwise visible widgets are updated first, largest on-screen
+    // area first, and the rest in slices of at most |msecs|. Widgets below a sharing scope are
+    // queued ahead of them and their scope sheets are applied once all of them have been
+    // collected, so a scoped subtree switches in one step. themeChangedFinished is emitted
+    // once the queue drains, and a newer theme/color change restarts the queue.
+    void setUpdateTimeSlice(int msecs);
+    int updateTimeSlice() const;
+
+    bool isUpdatePending() const;
+    int pendingUpdateCount() const;
+    // Drops the queued widgets; they are left dirty and restyled when they are next painted.
+    // A pending themeChangedFinished is emitted right away.
+    void cancelPendingUpdate();
+
+signals:
+    void styleSheetUpdateProgress(int done, int total);
+    void styleSheetUpdateFinished();
+
 public slots:
     void updateStyleSheet(bool lazy = false);
 
 private:
     explicit StyleSheetManager(QObject* parent = nullptr);
 
+    void scheduleStyleSheetUpdate(bool lazy, bool notifyThemeFinished);
+    void processUpdateSlice();
+    void processPendingAt(int index);
+    void finishScopeRebuild();
+    void resetPendingUpdate();
+    void applyRegistered(QWidget* widget, const StyleSheetCompose& source);
+
+    // Registry entries live in insertion order; deregistered entries become tombstones
+    // (key == nullptr) until compact() squeezes them out and rebuilds the index.
     struct Item {
+        QWidget* key = nullptr;
         QPointer<QWidget> widget;
         QSharedPointer<StyleSheetCompose> source;
+        size_t appliedHash = 0;
+        bool hashValid = false;
+    };
+
+    // Unique bundled sheets collected from the widgets below a sharing scope, plus the
+    // scope's own sheet if it is registered itself.
+    struct SharedScope {
+        QStringList sheets;
+        QSet<QString> sheetSet;
+        QString ownSheet;
+        QMetaObject::Connection destroyedConnection;
     };
 
+    void removeAt(int index);
+    void compact();
+    QWidget* sharingScopeFor(QWidget* widget) const;
+    void flushScope(QWidget* scope);
+
     QList<Item> items_;
+    QHash<QWidget*, int> index_;
+    QHash<QWidget*, SharedScope> scopes_;
+    int tombstones_ = 0;
+    int compactions_ = 0;
+    bool updating_ = false;
     bool nextLazyUpdate_ = false;
+
+    QTimer sliceTimer_;
+    QList<QPointer<QWidget>> pending_;
+    int pendingPos_ = 0;
+    int pendingTotal_ = 0;
+    int pendingDone_ = 0;
+    int timeSliceMs_ = 0;
+    // Leading pending_ entries that belong to sharing scopes still being rebuilt
+    int scopedPending_ = 0;
+    bool notifyThemeFinished_ = false;
 };
 
 }  // namespace qfw
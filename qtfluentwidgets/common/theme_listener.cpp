@@ -2,40 +2,79 @@
 
 #include <QApplication>
 #include <QPalette>
+#include <QStyleHints>
 
 namespace qfw {
 
 SystemThemeListener::SystemThemeListener(QObject* parent)
-    : QThread(parent), checkTimer_(new QTimer(this)) {
-    // Connect timer to check system theme periodically
-    connect(checkTimer_, &QTimer::timeout, this, &SystemThemeListener::onThemeChanged);
+    : QObject(parent), pollTimer_(new QTimer(this)) {
+    currentSystemTheme_ = detectSystemTheme();
 
-    // Check every 5 seconds (similar to darkdetect polling)
-    checkTimer_->start(5000);
+    connect(pollTimer_, &QTimer::timeout, this, &SystemThemeListener::checkSystemTheme);
+
+    // Platform themes update the application palette when the system theme changes
+    connect(&QConfig::instance(), &QConfig::applicationPaletteChanged, this,
+            &SystemThemeListener::scheduleCheck);
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    connect(QGuiApplication::styleHints(), &QStyleHints::colorSchemeChanged, this,
+            &SystemThemeListener::scheduleCheck);
+#endif
 }
 
-void SystemThemeListener::run() {
-    // Start the timer when thread runs
-    checkTimer_->start();
-    exec();  // Run event loop
+void SystemThemeListener::setPollingInterval(int msec) {
+    if (msec <= 0) {
+        pollTimer_->stop();
+        return;
+    }
+
+    pollTimer_->start(msec);
 }
 
-void SystemThemeListener::onThemeChanged() { checkSystemTheme(); }
+int SystemThemeListener::pollingInterval() const {
+    return pollTimer_->isActive() ? pollTimer_->interval() : 0;
+}
+
+void SystemThemeListener::scheduleCheck() {
+    if (checkPending_) {
+        return;
+    }
+
+    checkPending_ = true;
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            checkPending_ = false;
+            checkSystemTheme();
+        },
+        Qt::QueuedConnection);
+}
+
+Theme SystemThemeListener::detectSystemTheme() {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    switch (QGuiApplication::styleHints()->colorScheme()) {
+        case Qt::ColorScheme::Dark:
+            return Theme::Dark;
+        case Qt::ColorScheme::Light:
+            return Theme::Light;
+        default:
+            break;
+    }
+#endif
 
-void SystemThemeListener::checkSystemTheme() {
     // Simple system theme detection using Qt palette
     // This is a simplified version - Python version uses darkdetect library
-    QPalette palette = QApplication::palette();
-    QColor windowColor = palette.color(QPalette::Window);
+    const QColor windowColor = QApplication::palette().color(QPalette::Window);
+    return (windowColor.lightnessF() < 0.5) ? Theme::Dark : Theme::Light;
+}
 
-    // Determine if system is in dark mode based on window color
-    Theme newTheme = (windowColor.lightnessF() < 0.5) ? Theme::Dark : Theme::Light;
+void SystemThemeListener::checkSystemTheme() {
+    const Theme newTheme = detectSystemTheme();
 
     // Only emit if theme actually changed and app is in AUTO mode
     if (newTheme != currentSystemTheme_) {
         currentSystemTheme_ = newTheme;
 
-        // Only emit if app is in AUTO mode and theme differs from current
         if (QConfig::instance().theme() == Theme::Auto) {
             emit systemThemeChanged(newTheme);
         }
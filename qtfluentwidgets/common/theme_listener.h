@@ -1,32 +1,39 @@
 #pragma once
 
-#include <QThread>
+#include <QObject>
 #include <QTimer>
 
 #include "common/config.h"
 
 namespace qfw {
 
-class SystemThemeListener : public QThread {
+// Follows the system light/dark setting through palette and color scheme change notifications
+// (QStyleHints::colorSchemeChanged on Qt >= 6.5). Lives on the GUI thread; polling is only an
+// opt-in fallback for platforms that report neither.
+class SystemThemeListener : public QObject {
     Q_OBJECT
 
 public:
     explicit SystemThemeListener(QObject* parent = nullptr);
 
-signals:
-    void systemThemeChanged(Theme theme);
+    // Re-check the system theme every |msec| milliseconds in addition to the change
+    // notifications; 0 (the default) disables polling.
+    void setPollingInterval(int msec);
+    int pollingInterval() const;
 
-protected:
-    void run() override;
+    Theme systemTheme() const { return currentSystemTheme_; }
 
-private slots:
-    void onThemeChanged();
+signals:
+    void systemThemeChanged(Theme theme);
 
 private:
+    void scheduleCheck();
     void checkSystemTheme();
-    
+    static Theme detectSystemTheme();
+
     Theme currentSystemTheme_ = Theme::Light;
-    QTimer* checkTimer_;
+    QTimer* pollTimer_;
+    bool checkPending_ = false;
 };
 
 }  // namespace qfw
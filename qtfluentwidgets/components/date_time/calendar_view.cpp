@@ -54,6 +54,62 @@ void CalendarScrollButton::paintEvent(QPaintEvent* e) {
     }
 }
 
+// =========================================================================
+// CalendarDateModel
+// =========================================================================
+
+CalendarDateModel::CalendarDateModel(QObject* parent) : QAbstractListModel(parent) {}
+
+void CalendarDateModel::reset(int rowCount, DateFunction date, TextFunction text) {
+    beginResetModel();
+    rowCount_ = qMax(0, rowCount);
+    date_ = std::move(date);
+    text_ = std::move(text);
+    endResetModel();
+}
+
+void CalendarDateModel::refresh() {
+    if (rowCount_ > 0) {
+        emit dataChanged(index(0, 0), index(rowCount_ - 1, 0));
+    }
+}
+
+void CalendarDateModel::setItemSize(const QSize& size) { itemSize_ = size; }
+
+QDate CalendarDateModel::date(int row) const {
+    return (date_ && row >= 0 && row < rowCount_) ? date_(row) : QDate();
+}
+
+int CalendarDateModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : rowCount_;
+}
+
+QVariant CalendarDateModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return {};
+    }
+
+    switch (role) {
+        case Qt::DisplayRole: {
+            const QDate d = date(index.row());
+            return (d.isValid() && text_) ? text_(d) : QString();
+        }
+        case Qt::UserRole:
+            return date(index.row());
+        case Qt::SizeHintRole:
+            return itemSize_;
+        default:
+            return {};
+    }
+}
+
+Qt::ItemFlags CalendarDateModel::flags(const QModelIndex& index) const {
+    if (!date(index.row()).isValid()) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
 // =========================================================================
 // ScrollItemDelegate
 // =========================================================================
@@ -171,10 +227,13 @@ int DayScrollItemDelegate::itemMargin() const { return 3; }
 // =========================================================================
 
 ScrollViewBase::ScrollViewBase(ScrollItemDelegate* delegate, QWidget* parent)
-    : QListWidget(parent), delegate_(delegate) {
+    : QListView(parent), delegate_(delegate) {
     setProperty("qssClass", QStringLiteral("ScrollViewBase"));
     vScrollBar_ = new SmoothScrollBar(Qt::Vertical, this);
 
+    model_ = new CalendarDateModel(this);
+    setModel(model_);
+
     currentDate_ = QDate::currentDate();
     date_ = QDate::currentDate();
 
@@ -185,6 +244,7 @@ ScrollViewBase::ScrollViewBase(ScrollItemDelegate* delegate, QWidget* parent)
 }
 
 void ScrollViewBase::initialize() {
+    model_->setItemSize(gridSize());
     initItems();
     applyDateAndRange();
     initialized_ = true;
@@ -192,7 +252,7 @@ void ScrollViewBase::initialize() {
 
 void ScrollViewBase::initWidget() {
     setSpacing(0);
-    setMovement(QListWidget::Static);
+    setMovement(QListView::Static);
     setGridSize(gridSize());
     setViewportMargins(0, 0, 0, 0);
 
@@ -201,8 +261,8 @@ void ScrollViewBase::initWidget() {
         setItemDelegate(delegate_);
     }
 
-    setViewMode(QListWidget::IconMode);
-    setResizeMode(QListWidget::Adjust);
+    setViewMode(QListView::IconMode);
+    setResizeMode(QListView::Adjust);
 
     if (firstScroll_) {
         vScrollBar_->setScrollAnimation(1);
@@ -238,7 +298,6 @@ void ScrollViewBase::setYearRange(int minYear, int maxYear) {
     maxYear_ = maxYear;
 
     if (initialized_) {
-        clear();
         initItems();
         applyDateAndRange();
     }
@@ -304,14 +363,14 @@ void ScrollViewBase::wheelEvent(QWheelEvent* e) {
 }
 
 void ScrollViewBase::mousePressEvent(QMouseEvent* e) {
-    QListWidget::mousePressEvent(e);
+    QListView::mousePressEvent(e);
     if (e && e->button() == Qt::LeftButton && indexAt(e->pos()).row() >= 0) {
         setPressedIndex(currentIndex());
     }
 }
 
 void ScrollViewBase::mouseReleaseEvent(QMouseEvent* e) {
-    QListWidget::mouseReleaseEvent(e);
+    QListView::mouseReleaseEvent(e);
     setPressedIndex(QModelIndex());
 }
 
@@ -368,12 +427,8 @@ void CalendarViewBase::setScrollView(ScrollViewBase* view) {
     scrollView_ = view;
     vBoxLayout_->addWidget(view);
 
-    QObject::connect(view, &QListWidget::itemClicked, this, [this](QListWidgetItem* item) {
-        if (!item) {
-            return;
-        }
-
-        const QDate d = item->data(Qt::UserRole).toDate();
+    QObject::connect(view, &QAbstractItemView::clicked, this, [this](const QModelIndex& index) {
+        const QDate d = index.data(Qt::UserRole).toDate();
         if (d.isValid()) {
             emit itemClicked(d);
         }
@@ -425,17 +480,13 @@ YearScrollView::YearScrollView(QWidget* parent)
 }
 
 void YearScrollView::initItems() {
-    const int count = maxYear_ - minYear_ + 1;
-    for (int i = 0; i < count; ++i) {
-        const int year = minYear_ + i;
-        auto* it = new QListWidgetItem(QString::number(year), this);
-        it->setData(Qt::UserRole, QDate(year, 1, 1));
-        it->setSizeHint(gridSize());
-        addItem(it);
-
-        if (year == currentDate_.year() && delegate_) {
-            delegate_->setCurrentIndex(indexFromItem(it));
-        }
+    const int minYear = minYear_;
+    model_->reset(
+        maxYear_ - minYear_ + 1, [minYear](int row) { return QDate(minYear + row, 1, 1); },
+        [](const QDate& date) { return QString::number(date.year()); });
+
+    if (delegate_) {
+        delegate_->setCurrentIndex(model_->index(currentDate_.year() - minYear_, 0));
     }
 }
 
@@ -513,21 +564,16 @@ void MonthScrollView::initItems() {
         tr("Jul"), tr("Aug"), tr("Sep"), tr("Oct"), tr("Nov"), tr("Dec"),
     };
 
-    const int yearsCount = maxYear_ - minYear_ + 1;
-    const int total = yearsCount * 12;
+    const int minYear = minYear_;
+    const QStringList months = months_;
+    model_->reset(
+        (maxYear_ - minYear_ + 1) * 12,
+        [minYear](int row) { return QDate(row / 12 + minYear, row % 12 + 1, 1); },
+        [months](const QDate& date) { return months.value(date.month() - 1); });
 
-    for (int i = 0; i < total; ++i) {
-        const int year = i / 12 + minYear_;
-        const int m = i % 12 + 1;
-
-        auto* it = new QListWidgetItem(months_.value(m - 1), this);
-        it->setData(Qt::UserRole, QDate(year, m, 1));
-        it->setSizeHint(gridSize());
-        addItem(it);
-
-        if (year == currentDate_.year() && m == currentDate_.month() && delegate_) {
-            delegate_->setCurrentIndex(indexFromItem(it));
-        }
+    if (delegate_ && currentDate_.year() >= minYear_ && currentDate_.year() <= maxYear_) {
+        const int row = (currentDate_.year() - minYear_) * 12 + currentDate_.month() - 1;
+        delegate_->setCurrentIndex(model_->index(row, 0));
     }
 }
 
@@ -568,13 +614,10 @@ QDate MonthCalendarView::currentPageDate() const {
 
     const auto r = scrollView_->currentPageRange();
 
-    auto* item = scrollView_->currentItem();
     int month = 1;
-    if (item) {
-        const QDate d = item->data(Qt::UserRole).toDate();
-        if (d.isValid()) {
-            month = d.month();
-        }
+    const QDate d = scrollView_->currentIndex().data(Qt::UserRole).toDate();
+    if (d.isValid()) {
+        month = d.month();
     }
 
     return QDate(r.first.year(), month, 1);
@@ -616,32 +659,18 @@ QSize DayScrollView::gridSize() const { return QSize(44, 44); }
 void DayScrollView::initItems() {
     const QDate startDate(minYear_, 1, 1);
     const QDate endDate(maxYear_, 12, 31);
-    QDate current = startDate;
 
-    // placeholder items
-    const int bias = current.dayOfWeek() - 1;
-    for (int i = 0; i < bias; ++i) {
-        auto* it = new QListWidgetItem(this);
-        it->setFlags(Qt::NoItemFlags);
-        addItem(it);
-    }
-
-    QList<QDate> dates;
-    while (current <= endDate) {
-        dates.append(current);
-        addItem(QString::number(current.day()));
-        current = current.addDays(1);
-    }
-
-    for (int i = bias; i < count(); ++i) {
-        auto* it = item(i);
-        const QDate d = dates.value(i - bias);
-        it->setData(Qt::UserRole, d);
-        it->setSizeHint(gridSize());
-    }
+    // Placeholder rows align the first day with its weekday column
+    const int bias = startDate.dayOfWeek() - 1;
+    model_->reset(
+        bias + static_cast<int>(startDate.daysTo(endDate)) + 1,
+        [startDate, bias](int row) {
+            return row < bias ? QDate() : startDate.addDays(row - bias);
+        },
+        [](const QDate& date) { return QString::number(date.day()); });
 
     if (delegate_) {
-        delegate_->setCurrentIndex(model()->index(dateToRow(currentDate_), 0));
+        delegate_->setCurrentIndex(model_->index(dateToRow(currentDate_), 0));
     }
 }
 
@@ -693,7 +722,7 @@ QDate DayScrollView::pageToDate() const {
 
 int DayScrollView::dateToRow(const QDate& date) const {
     const QDate startDate(minYear_, 1, 1);
-    const int days = startDate.daysTo(date);
+    const int days = static_cast<int>(startDate.daysTo(date));
     return days + startDate.dayOfWeek() - 1;
 }
 
@@ -1,10 +1,11 @@
 #pragma once
 
+#include <QAbstractListModel>
 #include <QDate>
 #include <QFont>
 #include <QFrame>
 #include <QHash>
-#include <QListWidget>
+#include <QListView>
 #include <QModelIndex>
 #include <QMouseEvent>
 #include <QPair>
@@ -13,6 +14,7 @@
 #include <QString>
 #include <QStyleOptionViewItem>
 #include <QStyledItemDelegate>
+#include <functional>
 
 #include "common/icon.h"
 #include "components/widgets/button.h"
@@ -43,6 +45,37 @@ private:
     FluentIconEnum icon_;
 };
 
+// Items of a calendar scroll view. Dates and labels are computed from the row when a view asks
+// for them, so a range of centuries costs nothing until its rows are painted.
+class CalendarDateModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    using DateFunction = std::function<QDate(int row)>;
+    using TextFunction = std::function<QString(const QDate& date)>;
+
+    explicit CalendarDateModel(QObject* parent = nullptr);
+
+    // Rows whose date is invalid are disabled placeholders
+    void reset(int rowCount, DateFunction date, TextFunction text);
+    // Re-reads every row, for views that show another page in the same rows
+    void refresh();
+
+    void setItemSize(const QSize& size);
+
+    QDate date(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    int rowCount_ = 0;
+    DateFunction date_;
+    TextFunction text_;
+    QSize itemSize_;
+};
+
 class ScrollItemDelegate : public QStyledItemDelegate {
     Q_OBJECT
 
@@ -97,7 +130,7 @@ protected:
     int itemMargin() const override;
 };
 
-class ScrollViewBase : public QListWidget {
+class ScrollViewBase : public QListView {
     Q_OBJECT
 
 public:
@@ -138,6 +171,7 @@ protected:
 
     SmoothScrollBar* vScrollBar_ = nullptr;
     ScrollItemDelegate* delegate_ = nullptr;
+    CalendarDateModel* model_ = nullptr;
 
     QDate currentDate_;
     QDate date_;
@@ -152,15 +152,14 @@ int FastYearScrollView::startYear() const {
 }
 
 void FastYearScrollView::initItems() {
-    clear();
-
-    for (int i = 0; i < 16; ++i) {
-        addItem(QString());
-        auto* it = item(i);
-        if (it) {
-            it->setSizeHint(gridSize());
-        }
-    }
+    // 16 fixed rows showing the years around the current decade page
+    model_->reset(
+        16,
+        [this](int row) {
+            const int s = currentPageRange().first.year();
+            return QDate(s - (s - minYear_) % 4 + row, 1, 1);
+        },
+        [](const QDate& date) { return QString::number(date.year()); });
 
     updateItems();
 }
@@ -188,22 +187,7 @@ QPair<QDate, QDate> FastYearScrollView::currentPageRange() const {
 }
 
 void FastYearScrollView::updateItems() {
-    const auto r = currentPageRange();
-    const int s = r.first.year();
-
-    const int index = (s - minYear_) % 4;
-    const int left = s - index;
-    const int right = left + 16;
-
-    for (int i = 0; i < 16; ++i) {
-        const int year = left + i;
-        auto* it = item(i);
-        if (!it) {
-            continue;
-        }
-        it->setText(QString::number(year));
-        it->setData(Qt::UserRole, QDate(year, 1, 1));
-    }
+    model_->refresh();
 
     if (delegate_) {
         delegate_->setCurrentIndex(QModelIndex());
@@ -222,24 +206,19 @@ FastMonthScrollView::FastMonthScrollView(QWidget* parent)
 }
 
 void FastMonthScrollView::initItems() {
-    clear();
-
     const auto loc = QLocale::system();
     months_.clear();
     for (int m = 1; m <= 12; ++m) {
         months_.append(loc.standaloneMonthName(m, QLocale::ShortFormat));
     }
-    for (int m = 1; m <= 4; ++m) {
-        months_.append(loc.standaloneMonthName(m, QLocale::ShortFormat));
-    }
 
-    for (int i = 0; i < months_.size(); ++i) {
-        addItem(months_.at(i));
-        auto* it = item(i);
-        if (it) {
-            it->setSizeHint(gridSize());
-        }
-    }
+    // The page's year followed by the first four months of the next one
+    model_->reset(
+        16,
+        [this](int row) {
+            return QDate(minYear_ + currentPage_ + (row > 11 ? 1 : 0), row % 12 + 1, 1);
+        },
+        [this](const QDate& date) { return months_.value(date.month() - 1); });
 
     updateItems();
 }
@@ -262,17 +241,7 @@ QPair<QDate, QDate> FastMonthScrollView::currentPageRange() const {
 }
 
 void FastMonthScrollView::updateItems() {
-    const int year = minYear_ + currentPage_;
-
-    for (int i = 0; i < 16; ++i) {
-        const int m = i % 12 + 1;
-        const int y = year + (i > 11 ? 1 : 0);
-        auto* it = item(i);
-        if (it) {
-            it->setData(Qt::UserRole, QDate(y, m, 1));
-        }
-    }
-
+    model_->refresh();
     viewport()->update();
 }
 
@@ -325,15 +294,14 @@ int FastDayScrollView::pageCount() const {
 }
 
 void FastDayScrollView::initItems() {
-    clear();
-
-    for (int i = 0; i < 42; ++i) {
-        addItem(QString());
-        auto* it = item(i);
-        if (it) {
-            it->setSizeHint(gridSize());
-        }
-    }
+    // Six weeks starting on the Monday on or before the first day of the page's month
+    model_->reset(
+        42,
+        [this](int row) {
+            const QDate first = pageToDate();
+            return first.isValid() ? first.addDays(row - first.dayOfWeek() + 1) : QDate();
+        },
+        [](const QDate& date) { return QString::number(date.day()); });
 
     updateItems();
 }
@@ -374,36 +342,14 @@ QDate FastDayScrollView::pageToDate() const {
 }
 
 void FastDayScrollView::updateItems() {
-    const QDate first = pageToDate();
-    if (!first.isValid()) {
-        return;
-    }
-
-    QDate left = first.addDays(-first.dayOfWeek() + 1);
-
-    for (int i = 0; i < 42; ++i) {
-        QDate d = left.addDays(i);
-        auto* it = item(i);
-        if (!it) {
-            continue;
-        }
-        it->setText(QString::number(d.day()));
-        it->setData(Qt::UserRole, d);
-        it->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable);
-    }
-
+    model_->refresh();
     viewport()->update();
 }
 
 void FastDayScrollView::mouseReleaseEvent(QMouseEvent* e) {
     ScrollViewBase::mouseReleaseEvent(e);
 
-    auto* it = currentItem();
-    if (!it) {
-        return;
-    }
-
-    const QDate d = it->data(Qt::UserRole).toDate();
+    const QDate d = currentIndex().data(Qt::UserRole).toDate();
     if (!d.isValid()) {
         return;
     }
@@ -451,13 +397,10 @@ QDate FastMonthCalendarView::currentPageDate() const {
 
     const auto r = scrollView_->currentPageRange();
 
-    auto* item = scrollView_->currentItem();
     int month = 1;
-    if (item) {
-        const QDate d = item->data(Qt::UserRole).toDate();
-        if (d.isValid()) {
-            month = d.month();
-        }
+    const QDate d = scrollView_->currentIndex().data(Qt::UserRole).toDate();
+    if (d.isValid()) {
+        month = d.month();
     }
 
     return QDate(r.first.year(), month, 1);
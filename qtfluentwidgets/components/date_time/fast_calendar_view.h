@@ -2,7 +2,7 @@
 
 #include <QDate>
 #include <QFont>
-#include <QListWidget>
+#include <QListView>
 #include <QModelIndex>
 #include <QPair>
 #include <QStyledItemDelegate>
@@ -7,7 +7,7 @@
 #include <QFrame>
 #include <QGraphicsDropShadowEffect>
 #include <QHBoxLayout>
-#include <QListWidgetItem>
+#include <QPointer>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QPropertyAnimation>
@@ -77,17 +77,16 @@ void ItemMaskWidget::paintEvent(QPaintEvent* e) {
 
     for (int i = 0; i < listWidgets_->count(); ++i) {
         auto* listWidget = (*listWidgets_)[i];
-        if (!listWidget || !listWidget->currentItem()) {
+        if (!listWidget || listWidget->currentIndex() < 0) {
             continue;
         }
 
         // Get the current selected item
-        auto* item = listWidget->currentItem();
-        int itemWidth = item->sizeHint().width();
+        int itemWidth = listWidget->itemSize().width();
 
         // Draw the item text centered in the mask area
         // The mask is positioned at the center row of the list widget
-        Qt::Alignment align = static_cast<Qt::Alignment>(item->textAlignment());
+        Qt::Alignment align = listWidget->alignment() | Qt::AlignVCenter;
         QRectF textRect;
 
         if (align & Qt::AlignLeft) {
@@ -99,18 +98,18 @@ void ItemMaskWidget::paintEvent(QPaintEvent* e) {
         }
 
         // Center vertically
-        painter.drawText(textRect, align | Qt::AlignVCenter, item->text());
+        painter.drawText(textRect, align | Qt::AlignVCenter, listWidget->currentText());
 
         xOffset += (itemWidth + 8);  // margin: 0 4px;
     }
 }
 
-void ItemMaskWidget::drawText(QListWidgetItem* item, QPainter* painter, int y) {
-    if (!item || !painter) return;
+void ItemMaskWidget::drawText(CycleListWidget* listWidget, QPainter* painter, int y) {
+    if (!listWidget || !painter) return;
 
-    auto align = item->textAlignment();
-    int w = item->sizeHint().width();
-    int h = item->sizeHint().height();
+    auto align = listWidget->alignment() | Qt::AlignVCenter;
+    int w = listWidget->itemSize().width();
+    int h = listWidget->itemSize().height();
 
     QRectF rect;
     if (align & Qt::AlignLeft) {
@@ -121,7 +120,7 @@ void ItemMaskWidget::drawText(QListWidgetItem* item, QPainter* painter, int y) {
         rect = QRectF(4, y, w, h);
     }
 
-    painter->drawText(rect, align, item->text());
+    painter->drawText(rect, align, listWidget->currentText());
 }
 
 PickerColumnFormatter::PickerColumnFormatter(QObject* parent) : QObject(parent) {}
@@ -209,6 +208,34 @@ QStringList PickerColumnButton::items() const {
 
 void PickerColumnButton::setItems(const QVariantList& items) { items_ = items; }
 
+int PickerColumnButton::itemCount() const { return static_cast<int>(items_.size()); }
+
+QString PickerColumnButton::itemText(int index) const {
+    if (index < 0 || index >= items_.size()) {
+        return QString();
+    }
+    return formatter_ ? formatter_->encode(items_.at(index)) : items_.at(index).toString();
+}
+
+int PickerColumnButton::itemIndex(const QString& text) const {
+    const QVariant value = formatter_ ? formatter_->decode(text) : QVariant(text);
+
+    // Decoded values may differ in type from the items, e.g. an int for "05" against "5"
+    int index = static_cast<int>(items_.indexOf(value));
+    if (index < 0) {
+        index = static_cast<int>(items_.indexOf(QVariant(value.toString())));
+    }
+    if (index < 0) {
+        bool ok = false;
+        const int number = value.toInt(&ok);
+        if (ok) {
+            index = static_cast<int>(items_.indexOf(QVariant(number)));
+        }
+    }
+
+    return (index >= 0 && itemText(index) == text) ? index : -1;
+}
+
 PickerColumnFormatter* PickerColumnButton::formatter() const { return formatter_; }
 
 void PickerColumnButton::setFormatter(PickerColumnFormatter* formatter) {
@@ -426,7 +453,12 @@ void PickerBase::showPanel() {
 
     for (auto* column : columns_) {
         if (column && column->isVisible()) {
-            panel->addColumn(column->items(), column->width(), column->align());
+            // Rows are formatted when shown instead of encoding every value up front
+            const QPointer<PickerColumnButton> c(column);
+            panel->addColumn(
+                column->itemCount(), [c](int i) { return c ? c->itemText(i) : QString(); },
+                column->width(), column->align(),
+                [c](const QString& text) { return c ? c->itemIndex(text) : -1; });
         }
     }
 
@@ -550,24 +582,31 @@ void PickerPanel::setSelectedBackgroundColor(const QColor& light, const QColor&
 bool PickerPanel::isResetEnabled() const { return resetButton_->isVisible(); }
 
 void PickerPanel::addColumn(const QStringList& items, int width, Qt::Alignment align) {
+    addColumn(static_cast<int>(items.size()), [items](int index) { return items.value(index); },
+              width, align);
+}
+
+void PickerPanel::addColumn(int count, std::function<QString(int index)> generator, int width,
+                            Qt::Alignment align, std::function<int(const QString& text)> indexOf) {
     if (!listWidgets_.isEmpty()) {
         listLayout_->addWidget(new SeparatorWidget(Qt::Vertical, view_));
     }
 
-    auto* w = new CycleListWidget(items, QSize(width, itemHeight_), align, this);
+    auto* w = new CycleListWidget(count, std::move(generator), QSize(width, itemHeight_), align,
+                                  this);
     w->setScrollButtonRepeatEnabled(scrollButtonRepeatEnabled_);
+    if (indexOf) {
+        w->setIndexLookup(std::move(indexOf));
+    }
 
-    connect(w, &CycleListWidget::cycleCurrentItemChanged, itemMaskWidget_,
+    connect(w, &CycleListWidget::cycleCurrentTextChanged, itemMaskWidget_,
             QOverload<>::of(&QWidget::update));
     connect(w->verticalScrollBar(), &QScrollBar::valueChanged, itemMaskWidget_,
             QOverload<>::of(&QWidget::update));
 
     const int idx = listWidgets_.size();
-    connect(w, &CycleListWidget::cycleCurrentItemChanged, this, [this, idx](QListWidgetItem* item) {
-        if (item) {
-            emit columnValueChanged(idx, item->text());
-        }
-    });
+    connect(w, &CycleListWidget::cycleCurrentTextChanged, this,
+            [this, idx](const QString& text) { emit columnValueChanged(idx, text); });
 
     listWidgets_.append(w);
     listLayout_->addWidget(w);
@@ -576,8 +615,8 @@ void PickerPanel::addColumn(const QStringList& items, int width, Qt::Alignment a
 QStringList PickerPanel::value() const {
     QStringList out;
     for (auto* w : listWidgets_) {
-        if (w && w->currentItem()) {
-            out.append(w->currentItem()->text());
+        if (w) {
+            out.append(w->currentText());
         }
     }
     return out;
@@ -598,8 +637,7 @@ QString PickerPanel::columnValue(int index) const {
         return QString();
     }
 
-    auto* item = listWidgets_[index]->currentItem();
-    return item ? item->text() : QString();
+    return listWidgets_[index]->currentText();
 }
 
 void PickerPanel::setColumnValue(int index, const QString& value) {
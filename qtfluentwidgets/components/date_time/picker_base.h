@@ -3,13 +3,13 @@
 #include <QColor>
 #include <QGraphicsDropShadowEffect>
 #include <QList>
-#include <QListWidgetItem>
 #include <QObject>
 #include <QPropertyAnimation>
 #include <QPushButton>
 #include <QStringList>
 #include <QVariant>
 #include <QWidget>
+#include <functional>
 
 #include "components/widgets/button.h"
 #include "common/qtcompat.h"
@@ -43,7 +43,7 @@ protected:
     void paintEvent(QPaintEvent* e) override;
 
 private:
-    void drawText(QListWidgetItem* item, QPainter* painter, int y);
+    void drawText(CycleListWidget* listWidget, QPainter* painter, int y);
 
     QList<CycleListWidget*>* listWidgets_;
     QColor lightBackgroundColor_;
@@ -88,6 +88,12 @@ public:
     QStringList items() const;
     void setItems(const QVariantList& items);
 
+    // Formats one item at a time, for panels that generate their rows lazily
+    int itemCount() const;
+    QString itemText(int index) const;
+    // Index of the item whose text is |text|, found by decoding it; -1 if none
+    int itemIndex(const QString& text) const;
+
     PickerColumnFormatter* formatter() const;
     void setFormatter(PickerColumnFormatter* formatter);
 
@@ -128,6 +134,11 @@ public:
     bool isResetEnabled() const;
 
     void addColumn(const QStringList& items, int width, Qt::Alignment align = Qt::AlignCenter);
+    // |generator| returns the text of item 0 <= index < count when the row is shown, and
+    // |indexOf| maps a text back to its index so setValue() doesn't format the whole column
+    void addColumn(int count, std::function<QString(int index)> generator, int width,
+                   Qt::Alignment align = Qt::AlignCenter,
+                   std::function<int(const QString& text)> indexOf = nullptr);
 
     QStringList value() const;
     void setValue(const QStringList& value);
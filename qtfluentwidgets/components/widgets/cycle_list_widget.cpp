@@ -54,23 +54,119 @@ void ScrollButton::paintEvent(QPaintEvent* e) {
                       : QVariantMap{{QStringLiteral("fill"), QStringLiteral("#5e5e5e")}});
 }
 
+// ============================================================================
+// CycleListModel
+// ============================================================================
+
+// A cycling range is laid out three times; the view jumps back to the middle copy before
+// either end becomes visible
+static constexpr int kCycleCopies = 3;
+
+CycleListModel::CycleListModel(QObject* parent) : QAbstractListModel(parent) {}
+
+void CycleListModel::setItems(int count, ItemGenerator generator, bool cycle, int padding) {
+    beginResetModel();
+    count_ = qMax(0, count);
+    generator_ = std::move(generator);
+    cycle_ = cycle && count_ > 0;
+    padding_ = cycle_ ? 0 : qMax(0, padding);
+    endResetModel();
+}
+
+void CycleListModel::setItemSize(const QSize& size) { itemSize_ = size; }
+
+void CycleListModel::setAlignment(Qt::Alignment align) { align_ = align; }
+
+int CycleListModel::itemCount() const { return count_; }
+
+bool CycleListModel::isCycle() const { return cycle_; }
+
+int CycleListModel::firstRow() const { return cycle_ ? count_ : padding_; }
+
+int CycleListModel::itemIndex(int row) const {
+    if (row < 0 || row >= rowCount()) {
+        return -1;
+    }
+
+    if (cycle_) {
+        return row % count_;
+    }
+
+    const int index = row - padding_;
+    return index < count_ ? index : -1;
+}
+
+QString CycleListModel::text(int row) const {
+    const int index = itemIndex(row);
+    return (index >= 0 && generator_) ? generator_(index) : QString();
+}
+
+int CycleListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) {
+        return 0;
+    }
+    return cycle_ ? count_ * kCycleCopies : count_ + 2 * padding_;
+}
+
+QVariant CycleListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return {};
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return text(index.row());
+        case Qt::SizeHintRole:
+            return itemSize_;
+        case Qt::TextAlignmentRole:
+            return static_cast<int>(align_ | Qt::AlignVCenter);
+        default:
+            return {};
+    }
+}
+
+Qt::ItemFlags CycleListModel::flags(const QModelIndex& index) const {
+    if (itemIndex(index.row()) < 0) {
+        return Qt::NoItemFlags;
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable;
+}
+
 // ============================================================================
 // CycleListWidget
 // ============================================================================
 
 CycleListWidget::CycleListWidget(const QStringList& items, const QSize& itemSize,
                                  Qt::Alignment align, QWidget* parent)
-    : QListWidget(parent), itemSize_(itemSize), align_(align) {
+    : QListView(parent), itemSize_(itemSize), align_(align) {
+    initWidget();
+    setItems(items);
+}
+
+CycleListWidget::CycleListWidget(int count, ItemGenerator generator, const QSize& itemSize,
+                                 Qt::Alignment align, QWidget* parent)
+    : QListView(parent), itemSize_(itemSize), align_(align) {
+    initWidget();
+    setItems(count, std::move(generator));
+}
+
+void CycleListWidget::initWidget() {
     setProperty("qssClass", QStringLiteral("CycleListWidget"));
     upButton_ = new ScrollButton(FluentIconEnum::CareUpSolid, this);
     downButton_ = new ScrollButton(FluentIconEnum::CareDownSolid, this);
 
-    originItems_ = items;
     lastScrollTime_ = QTime::currentTime();
 
-    vScrollBar_ = new SmoothScrollBar(Qt::Vertical, this);
+    compatItem_.setSizeHint(itemSize_);
+    compatItem_.setTextAlignment(static_cast<int>(align_ | Qt::AlignVCenter));
 
-    setItems(items);
+    model_ = new CycleListModel(this);
+    model_->setItemSize(itemSize_);
+    model_->setAlignment(align_);
+    setModel(model_);
+    setUniformItemSizes(true);
+
+    vScrollBar_ = new SmoothScrollBar(Qt::Vertical, this);
 
     setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
     vScrollBar_->setScrollAnimation(scrollDuration_);
@@ -82,7 +178,7 @@ CycleListWidget::CycleListWidget(const QStringList& items, const QSize& itemSize
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
-    connect(this, &QListWidget::itemClicked, this, &CycleListWidget::onItemClicked);
+    connect(this, &QAbstractItemView::clicked, this, &CycleListWidget::onItemClicked);
     installEventFilter(this);
 
     connect(upButton_, &QToolButton::clicked, this, &CycleListWidget::scrollUp);
@@ -106,62 +202,39 @@ void CycleListWidget::setVisibleNumber(int n) {
 
     visibleNumber_ = n;
     setFixedSize(itemSize_.width() + 8, itemSize_.height() * visibleNumber_);
-    setItems(originItems_);
+    createItems();
 }
 
 void CycleListWidget::setItems(const QStringList& items) {
-    originItems_ = items;
-    clear();
-    createItems(items);
+    setItems(static_cast<int>(items.size()), [items](int index) { return items.value(index); });
 }
 
-void CycleListWidget::createItems(const QStringList& items) {
-    const int N = items.size();
-    isCycle_ = N > visibleNumber_;
-
-    if (isCycle_) {
-        addColumnItems(items);
-        addColumnItems(items);
-
-        currentIndex_ = items.size();
-        if (currentIndex_ - visibleNumber_ / 2 >= 0) {
-            QListWidget::scrollToItem(item(currentIndex_ - visibleNumber_ / 2), PositionAtTop);
-        }
-    } else {
-        const int n = visibleNumber_ / 2;
-        QStringList empties;
-        empties.reserve(n);
-        for (int i = 0; i < n; ++i) {
-            empties << QString();
-        }
+void CycleListWidget::setItems(int count, ItemGenerator generator) {
+    itemCount_ = qMax(0, count);
+    generator_ = std::move(generator);
+    indexOf_ = IndexLookup();
+    createItems();
+}
 
-        addColumnItems(empties, true);
-        addColumnItems(items);
-        addColumnItems(empties, true);
+void CycleListWidget::setIndexLookup(IndexLookup indexOf) { indexOf_ = std::move(indexOf); }
 
-        currentIndex_ = n;
-    }
-}
+void CycleListWidget::createItems() {
+    const bool cycle = itemCount_ > visibleNumber_;
+    model_->setItems(itemCount_, generator_, cycle, visibleNumber_ / 2);
 
-void CycleListWidget::addColumnItems(const QStringList& items, bool disabled) {
-    for (const QString& s : items) {
-        auto* it = new QListWidgetItem(s, this);
-        it->setSizeHint(itemSize_);
-        it->setTextAlignment(align_ | Qt::AlignVCenter);
-        if (disabled) {
-            it->setFlags(Qt::NoItemFlags);
-        }
-        addItem(it);
+    currentIndex_ = model_->firstRow();
+    if (cycle && currentIndex_ - visibleNumber_ / 2 >= 0) {
+        QListView::scrollTo(model_->index(currentIndex_ - visibleNumber_ / 2, 0), PositionAtTop);
     }
 }
 
-void CycleListWidget::onItemClicked(QListWidgetItem* item) {
-    if (!item) {
+void CycleListWidget::onItemClicked(const QModelIndex& index) {
+    if (!(model_->flags(index) & Qt::ItemIsEnabled)) {
         return;
     }
 
-    setCurrentIndex(row(item));
-    scrollToItemInternal(currentItem());
+    setCurrentIndex(index.row());
+    scrollToItemInternal(currentIndex());
 }
 
 void CycleListWidget::setSelectedItem(const QString& text) {
@@ -169,33 +242,39 @@ void CycleListWidget::setSelectedItem(const QString& text) {
         return;
     }
 
-    const QList<QListWidgetItem*> items = findItems(text, Qt::MatchExactly);
-    if (items.isEmpty()) {
-        return;
-    }
-
-    if (items.size() >= 2) {
-        setCurrentIndex(row(items[1]));
+    // Texts are generated, so look the value up in the range rather than the rows; without a
+    // lookup, scanning formats every item
+    int found = -1;
+    if (indexOf_) {
+        found = indexOf_(text);
     } else {
-        setCurrentIndex(row(items[0]));
+        for (int i = 0; i < itemCount_; ++i) {
+            if (generator_(i) == text) {
+                found = i;
+                break;
+            }
+        }
+    }
+    if (found < 0 || found >= itemCount_) {
+        return;
     }
 
-    QListWidget::scrollToItem(currentItem(), PositionAtCenter);
+    setCurrentIndex(model_->firstRow() + found);
+    QListView::scrollTo(model_->index(currentIndex(), 0), PositionAtCenter);
 }
 
-void CycleListWidget::scrollToItemInternal(QListWidgetItem* item) {
-    if (!item) {
+void CycleListWidget::scrollToItemInternal(int row) {
+    if (row < 0 || row >= model_->rowCount()) {
         return;
     }
 
-    const int index = row(item);
-    const int y = item->sizeHint().height() * (index - visibleNumber_ / 2);
+    const int y = itemSize_.height() * (row - visibleNumber_ / 2);
     vScrollBar_->scrollTo(y);
 
     clearSelection();
-    item->setSelected(false);
 
-    emit cycleCurrentItemChanged(item);
+    emit cycleCurrentTextChanged(model_->text(row));
+    emit cycleCurrentItemChanged(currentItem());
 }
 
 void CycleListWidget::wheelEvent(QWheelEvent* e) {
@@ -224,6 +303,8 @@ bool CycleListWidget::isScrollButtonRepeatEnabled() const { return scrollButtonR
 
 QSize CycleListWidget::itemSize() const { return itemSize_; }
 
+Qt::Alignment CycleListWidget::alignment() const { return align_; }
+
 void CycleListWidget::scrollWithAnimation(int index) {
     const QTime t = QTime::currentTime();
     const int elapsed = lastScrollTime_.msecsTo(t);
@@ -239,7 +320,7 @@ void CycleListWidget::scrollWithAnimation(int index) {
 
     vScrollBar_->setScrollAnimation(duration, easing);
     setCurrentIndex(index);
-    scrollToItemInternal(currentItem());
+    scrollToItemInternal(currentIndex());
 }
 
 void CycleListWidget::scrollDown() { scrollWithAnimation(currentIndex() + 1); }
@@ -262,7 +343,7 @@ void CycleListWidget::leaveEvent(QEvent* e) {
 }
 
 void CycleListWidget::resizeEvent(QResizeEvent* e) {
-    QListWidget::resizeEvent(e);
+    QListView::resizeEvent(e);
 
     const int w = width();
     const int h = 34;
@@ -274,7 +355,7 @@ void CycleListWidget::resizeEvent(QResizeEvent* e) {
 
 bool CycleListWidget::eventFilter(QObject* obj, QEvent* e) {
     if (obj != this || !e || e->type() != QEvent::KeyPress) {
-        return QListWidget::eventFilter(obj, e);
+        return QListView::eventFilter(obj, e);
     }
 
     auto* ke = static_cast<QKeyEvent*>(e);
@@ -288,35 +369,36 @@ bool CycleListWidget::eventFilter(QObject* obj, QEvent* e) {
         return true;
     }
 
-    return QListWidget::eventFilter(obj, e);
+    return QListView::eventFilter(obj, e);
 }
 
-QListWidgetItem* CycleListWidget::currentItem() const { return item(currentIndex()); }
+QString CycleListWidget::currentText() const { return model_->text(currentIndex()); }
+
+QListWidgetItem* CycleListWidget::currentItem() const {
+    compatItem_.setText(currentText());
+    return &compatItem_;
+}
 
 int CycleListWidget::currentIndex() const { return currentIndex_; }
 
 void CycleListWidget::setCurrentIndex(int index) {
-    if (!isCycle_) {
-        const int n = visibleNumber_ / 2;
-        const int minIndex = n;
-        const int maxIndex = n + originItems_.size() - 1;
+    if (!model_->isCycle()) {
+        const int minIndex = model_->firstRow();
+        const int maxIndex = minIndex + itemCount_ - 1;
         currentIndex_ = qMax(minIndex, qMin(maxIndex, index));
         return;
     }
 
-    const int N = count() / 2;
-    const int m = (visibleNumber_ + 1) / 2;
+    // Leaving the middle copy: continue from the same item in it, jumping the view to where
+    // the previous item is centered so the animation still moves by one row
+    const int n = itemCount_;
     currentIndex_ = index;
-
-    // scroll to center to achieve circular scrolling
-    if (index >= count() - m) {
-        currentIndex_ = N + index - count();
-        if (currentIndex_ - 1 >= 0) {
-            QListWidget::scrollToItem(item(currentIndex_ - 1), PositionAtCenter);
-        }
-    } else if (index <= m - 1) {
-        currentIndex_ = N + index;
-        QListWidget::scrollToItem(item(N + index + 1), PositionAtCenter);
+    if (index >= 2 * n) {
+        currentIndex_ = index - n;
+        QListView::scrollTo(model_->index(currentIndex_ - 1, 0), PositionAtCenter);
+    } else if (index < n) {
+        currentIndex_ = index + n;
+        QListView::scrollTo(model_->index(currentIndex_ + 1, 0), PositionAtCenter);
     }
 }
 
@@ -1,9 +1,12 @@
 #pragma once
 
-#include <QListWidget>
+#include <QAbstractListModel>
+#include <QListView>
+#include <QListWidgetItem>
 #include <QSize>
 #include <QTime>
 #include <QToolButton>
+#include <functional>
 
 #include "common/qtcompat.h"
 #include "common/icon.h"
@@ -27,20 +30,71 @@ private:
     bool isPressed_ = false;
 };
 
-class CycleListWidget : public QListWidget {
+// Rows of a CycleListWidget. Texts come from a generator when a row is painted, and a cycling
+// column repeats its range through modular row arithmetic instead of duplicated items.
+class CycleListModel : public QAbstractListModel {
     Q_OBJECT
 
 public:
+    using ItemGenerator = std::function<QString(int index)>;
+
+    explicit CycleListModel(QObject* parent = nullptr);
+
+    // |padding| disabled rows go around a non-cycling range so its ends can reach the center
+    void setItems(int count, ItemGenerator generator, bool cycle, int padding);
+    void setItemSize(const QSize& size);
+    void setAlignment(Qt::Alignment align);
+
+    int itemCount() const;
+    bool isCycle() const;
+
+    // Row of the first item in the middle copy of a cycling range, or after the padding
+    int firstRow() const;
+    // Index into the range shown by |row|, -1 for padding
+    int itemIndex(int row) const;
+    QString text(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private:
+    int count_ = 0;
+    ItemGenerator generator_;
+    bool cycle_ = false;
+    int padding_ = 0;
+    QSize itemSize_;
+    Qt::Alignment align_ = Qt::AlignCenter;
+};
+
+class CycleListWidget : public QListView {
+    Q_OBJECT
+
+public:
+    using ItemGenerator = CycleListModel::ItemGenerator;
+    // Maps a text back to its index in the range, -1 if unknown
+    using IndexLookup = std::function<int(const QString& text)>;
+
     explicit CycleListWidget(const QStringList& items, const QSize& itemSize,
                              Qt::Alignment align = Qt::AlignCenter, QWidget* parent = nullptr);
+    // Texts are generated on demand, so opening a long column costs nothing up front
+    CycleListWidget(int count, ItemGenerator generator, const QSize& itemSize,
+                    Qt::Alignment align = Qt::AlignCenter, QWidget* parent = nullptr);
 
     void setItems(const QStringList& items);
+    void setItems(int count, ItemGenerator generator);
+    // Lets setSelectedItem() find generated texts without formatting the whole range
+    void setIndexLookup(IndexLookup indexOf);
     void setSelectedItem(const QString& text);
 
     int visibleNumber() const;
     void setVisibleNumber(int n);
 
     int currentIndex() const;
+    QString currentText() const;
+
+    // Deprecated: rows are generated, so this is a detached item describing the current row.
+    // Use currentText() instead.
     QListWidgetItem* currentItem() const;
 
     void setCurrentIndex(int index);
@@ -49,12 +103,15 @@ public:
     bool isScrollButtonRepeatEnabled() const;
 
     QSize itemSize() const;
+    Qt::Alignment alignment() const;
 
 public slots:
     void scrollDown();
     void scrollUp();
 
 signals:
+    void cycleCurrentTextChanged(const QString& text);
+    // Deprecated: emitted with currentItem() after cycleCurrentTextChanged()
     void cycleCurrentItemChanged(QListWidgetItem* item);
 
 protected:
@@ -65,10 +122,10 @@ protected:
     bool eventFilter(QObject* obj, QEvent* e) override;
 
 private:
-    void createItems(const QStringList& items);
-    void addColumnItems(const QStringList& items, bool disabled = false);
-    void scrollToItemInternal(QListWidgetItem* item);
-    void onItemClicked(QListWidgetItem* item);
+    void initWidget();
+    void createItems();
+    void scrollToItemInternal(int row);
+    void onItemClicked(const QModelIndex& index);
 
     void setButtonsVisible(bool visible);
     void scrollWithAnimation(int index);
@@ -76,16 +133,20 @@ private:
     QSize itemSize_;
     Qt::Alignment align_;
 
+    CycleListModel* model_ = nullptr;
+    int itemCount_ = 0;
+    ItemGenerator generator_;
+    IndexLookup indexOf_;
+    mutable QListWidgetItem compatItem_;
+
     ScrollButton* upButton_ = nullptr;
     ScrollButton* downButton_ = nullptr;
 
     SmoothScrollBar* vScrollBar_ = nullptr;
 
     int scrollDuration_ = 250;
-    QStringList originItems_;
 
     int visibleNumber_ = 9;
-    bool isCycle_ = false;
     int currentIndex_ = 0;
 
     QTime lastScrollTime_;
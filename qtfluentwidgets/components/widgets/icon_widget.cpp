@@ -69,7 +69,7 @@ void IconWidget::paintEvent(QPaintEvent* event) {
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
     if (fluentIcon_) {
-        fluentIcon_->render(&painter, rect(), Theme::Auto, {});
+        fluentIcon_->render(&painter, rect(), Theme::Auto);
         return;
     }
 
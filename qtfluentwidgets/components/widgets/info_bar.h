@@ -35,6 +35,7 @@ public:
     explicit InfoBarIcon(InfoBarIconEnum icon);
 
     QString path(Theme theme = Theme::Auto) const override;
+    using FluentIconBase::render;
     void render(QPainter* painter, const QRect& rect, Theme theme = Theme::Auto,
                 const QVariantMap& attributes = {}) const override;
     FluentIconBase* clone() const override;
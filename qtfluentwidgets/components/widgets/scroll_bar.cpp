@@ -641,6 +641,16 @@ bool SmoothScrollDelegate::eventFilter(QObject* obj, QEvent* event) {
         angleDelta = pixelDelta;
     }
 
+    // Touchpad begin/end events carry no delta but start and release a kinetic gesture
+    if (angleDelta.isNull()) {
+        if (!useAni_ && wheelEvent->phase() != Qt::NoScrollPhase) {
+            verticalSmoothScroll_->wheelEvent(wheelEvent);
+            horizonSmoothScroll_->wheelEvent(wheelEvent);
+        }
+        wheelEvent->setAccepted(true);
+        return true;
+    }
+
     bool verticalAtEnd =
         (angleDelta.y() < 0 && vScrollBar_->value() == vScrollBar_->maximum()) ||
         (angleDelta.y() > 0 && vScrollBar_->value() == vScrollBar_->minimum());
@@ -0,0 +1,151 @@
+// SmoothScroll frame cost benchmark.
+//
+// Usage: qfw_bench_smooth_scroll [-platform offscreen] [rows]
+//
+// Flings a TableView backed by a generated model (100k rows by default) with a burst of wheel
+// notches and runs the event loop until the motion settles. For every smooth mode it reports
+// the number of frames that moved the view, the process CPU time per frame and the wall time
+// of the fling. The scroll position is reset between runs.
+
+#include <QAbstractTableModel>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QScrollBar>
+#include <QWheelEvent>
+#include <cstdio>
+#include <ctime>
+
+#include "common/smooth_scroll.h"
+#include "components/widgets/scroll_bar.h"
+#include "components/widgets/table_view.h"
+
+using namespace qfw;
+
+namespace {
+
+class GeneratedTableModel final : public QAbstractTableModel {
+public:
+    explicit GeneratedTableModel(int rows) : rows_(rows) {}
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : rows_;
+    }
+
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : 5;
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override {
+        if (role != Qt::DisplayRole) {
+            return QVariant();
+        }
+        return QStringLiteral("Row %1, column %2").arg(index.row()).arg(index.column());
+    }
+
+private:
+    int rows_;
+};
+
+struct FlingResult {
+    int frames = 0;
+    double cpuMs = 0;
+    double wallMs = 0;
+};
+
+void processEventsFor(int msecs) {
+    QElapsedTimer timer;
+    timer.start();
+    while (timer.elapsed() < msecs) {
+        QApplication::processEvents(QEventLoop::AllEvents, 5);
+    }
+}
+
+FlingResult fling(TableView* view, int notches) {
+    QScrollBar* bar = view->verticalScrollBar();
+    bar->setValue(0);
+    processEventsFor(50);
+
+    FlingResult result;
+    const QMetaObject::Connection counter =
+        QObject::connect(bar, &QScrollBar::valueChanged, [&result] { ++result.frames; });
+
+    QElapsedTimer wall;
+    wall.start();
+    const std::clock_t cpuStart = std::clock();
+
+    // A quick burst of notches, as from a flicked wheel
+    const QPointF pos(view->viewport()->width() / 2.0, view->viewport()->height() / 2.0);
+    for (int i = 0; i < notches; ++i) {
+        QWheelEvent e(pos, QPointF(view->viewport()->mapToGlobal(pos.toPoint())), QPoint(),
+                      QPoint(0, -120), Qt::NoButton, Qt::NoModifier, Qt::NoScrollPhase, false);
+        QApplication::sendEvent(view->viewport(), &e);
+        QApplication::processEvents(QEventLoop::AllEvents, 5);
+    }
+
+    // Settled once the bar hasn't moved for a while
+    int lastFrames = -1;
+    QElapsedTimer idle;
+    idle.start();
+    while (idle.elapsed() < 300 && wall.elapsed() < 10000) {
+        QApplication::processEvents(QEventLoop::AllEvents, 5);
+        if (result.frames != lastFrames) {
+            lastFrames = result.frames;
+            idle.restart();
+        }
+    }
+
+    result.cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result.wallMs = static_cast<double>(wall.elapsed() - idle.elapsed());
+    QObject::disconnect(counter);
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QApplication app(argc, argv);
+    Q_INIT_RESOURCE(resource);
+
+    const QStringList args = app.arguments();
+    const int rows = args.size() > 1 ? args.at(1).toInt() : 100000;
+    if (rows <= 0) {
+        std::fprintf(stderr, "usage: qfw_bench_smooth_scroll [rows]\n");
+        return 2;
+    }
+
+    GeneratedTableModel model(rows);
+    TableView view;
+    view.setModel(&model);
+    view.resize(960, 640);
+    view.show();
+    processEventsFor(200);
+
+    auto* delegate = view.findChild<SmoothScrollDelegate*>();
+    if (!delegate) {
+        std::fprintf(stderr, "qfw_bench_smooth_scroll: TableView has no SmoothScrollDelegate\n");
+        return 1;
+    }
+
+    std::printf("%d rows, %d px viewport\n", rows, view.viewport()->height());
+    std::printf("%-10s %8s %12s %12s\n", "mode", "frames", "cpu/frame", "wall");
+
+    const struct {
+        const char* name;
+        SmoothMode mode;
+    } modes[] = {
+        {"Linear", SmoothMode::Linear},
+        {"Quadratic", SmoothMode::Quadratic},
+        {"Cosine", SmoothMode::Cosine},
+        {"Kinetic", SmoothMode::Kinetic},
+    };
+
+    for (const auto& m : modes) {
+        delegate->setSmoothMode(m.mode, Qt::Vertical);
+        fling(&view, 3);  // warm up the row cache
+        const FlingResult r = fling(&view, 12);
+        const double perFrame = r.frames > 0 ? r.cpuMs / r.frames : 0;
+        std::printf("%-10s %8d %9.3f ms %9.1f ms\n", m.name, r.frames, perFrame, r.wallMs);
+    }
+
+    return 0;
+}
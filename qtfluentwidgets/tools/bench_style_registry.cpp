@@ -0,0 +1,157 @@
+// StyleSheetManager registry benchmark.
+//
+// Usage: qfw_bench_style_registry [-platform offscreen]
+//
+// Registers 5k, 20k and 50k widgets, looks each one up and destroys them in random order,
+// then churns a full registry by destroying and registering one widget at a time. Reports the
+// cost per operation, which should stay flat as the registry grows, and checks the compaction
+// policy after every removal: tombstones are squeezed out once there are more than 64 of them
+// and they make up more than half of the entries. Exits with 1 if that doesn't hold.
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QWidget>
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "common/style_sheet.h"
+
+using namespace qfw;
+
+namespace {
+
+bool g_failed = false;
+
+double nsPerOp(qint64 nsecs, int ops) { return ops > 0 ? static_cast<double>(nsecs) / ops : 0; }
+
+void checkCompactionPolicy(const char* phase) {
+    const StyleSheetRegistryStats s = StyleSheetManager::instance().registryStats();
+    if (s.tombstones > 64 && s.tombstones * 2 > s.entries) {
+        if (!g_failed) {
+            std::fprintf(stderr, "%s: %d tombstones of %d entries were not compacted\n", phase,
+                         s.tombstones, s.entries);
+        }
+        g_failed = true;
+    }
+}
+
+QSharedPointer<StyleSheetBase> buttonSheet() {
+    return QSharedPointer<StyleSheetBase>(new FluentStyleSheetSource(FluentStyleSheet::Button));
+}
+
+void registerAll(const std::vector<QWidget*>& widgets) {
+    auto& manager = StyleSheetManager::instance();
+    for (QWidget* w : widgets) {
+        manager.registerWidget(w, buttonSheet());
+    }
+}
+
+std::vector<QWidget*> createWidgets(int count) {
+    std::vector<QWidget*> widgets;
+    widgets.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        widgets.push_back(new QWidget);
+    }
+    return widgets;
+}
+
+void runSize(int count) {
+    auto& manager = StyleSheetManager::instance();
+    QElapsedTimer timer;
+
+    // Baseline: creating and destroying unregistered widgets
+    std::vector<QWidget*> plain = createWidgets(count);
+    timer.start();
+    for (QWidget* w : plain) {
+        delete w;
+    }
+    const qint64 plainDestroyNs = timer.nsecsElapsed();
+
+    std::vector<QWidget*> widgets = createWidgets(count);
+    timer.start();
+    registerAll(widgets);
+    const qint64 registerNs = timer.nsecsElapsed();
+
+    int found = 0;
+    timer.start();
+    for (QWidget* w : widgets) {
+        found += manager.source(w) ? 1 : 0;
+    }
+    const qint64 lookupNs = timer.nsecsElapsed();
+    if (found != count) {
+        std::fprintf(stderr, "%d of %d registered widgets not found\n", count - found, count);
+        g_failed = true;
+    }
+
+    std::shuffle(widgets.begin(), widgets.end(), *QRandomGenerator::global());
+    const int compactionsBefore = manager.registryStats().compactions;
+    qint64 destroyNs = 0;
+    for (QWidget* w : widgets) {
+        timer.start();
+        delete w;
+        destroyNs += timer.nsecsElapsed();
+        checkCompactionPolicy("destroy");
+    }
+
+    const StyleSheetRegistryStats left = manager.registryStats();
+    if (left.entries != left.tombstones) {
+        std::fprintf(stderr, "%d destroyed widgets still registered\n",
+                     left.entries - left.tombstones);
+        g_failed = true;
+    }
+
+    std::printf("%6d widgets: register %7.1f ns  lookup %6.1f ns  destroy %7.1f ns "
+                "(unregistered %7.1f ns)  compactions %d\n",
+                count, nsPerOp(registerNs, count), nsPerOp(lookupNs, count),
+                nsPerOp(destroyNs, count), nsPerOp(plainDestroyNs, count),
+                left.compactions - compactionsBefore);
+}
+
+void runChurn(int count, int rounds) {
+    auto& manager = StyleSheetManager::instance();
+    std::vector<QWidget*> widgets = createWidgets(count);
+    registerAll(widgets);
+
+    const int compactionsBefore = manager.registryStats().compactions;
+    int maxEntries = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < rounds; ++i) {
+        const int victim = QRandomGenerator::global()->bounded(count);
+        delete widgets[victim];
+        widgets[victim] = new QWidget;
+        manager.registerWidget(widgets[victim], buttonSheet());
+        checkCompactionPolicy("churn");
+        maxEntries = std::max(maxEntries, manager.registryStats().entries);
+    }
+    const qint64 churnNs = timer.nsecsElapsed();
+
+    std::printf("churn %d live, %d rounds: %7.1f ns per replace, max %d entries, "
+                "compactions %d\n",
+                count, rounds, nsPerOp(churnNs, rounds), maxEntries,
+                manager.registryStats().compactions - compactionsBefore);
+
+    for (QWidget* w : widgets) {
+        delete w;
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QApplication app(argc, argv);
+    Q_INIT_RESOURCE(resource);
+
+    for (int count : {5000, 20000, 50000}) {
+        runSize(count);
+    }
+    runChurn(50000, 100000);
+
+    if (g_failed) {
+        std::printf("FAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Build-time QSS precompiler.
+//
+// Usage: qfw_qss_compiler <output.cpp> <qss-dir>
+//
+// Reads <qss-dir>/{light,dark}/*.qss, applies the built-in type selector rewrites and splits
+// every sheet into literal and theme token segments. The result is serialized into one blob
+// and written as a C++ source exposing qfw::precompiledQssBlob(), so at runtime only the
+// theme color tokens are substituted.
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStringList>
+#include <cstdio>
+
+#include "common/qss_template.h"
+
+using namespace qfw;
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() != 3) {
+        std::fprintf(stderr, "usage: qfw_qss_compiler <output.cpp> <qss-dir>\n");
+        return 2;
+    }
+
+    const QString outputPath = args.at(1);
+    const QDir root(args.at(2));
+
+    QssSelectorRewriter rewriter;
+    QList<QPair<QString, QssTemplate>> templates;
+    for (const QString& theme : {QStringLiteral("light"), QStringLiteral("dark")}) {
+        const QDir dir(root.filePath(theme));
+        const QStringList files = dir.entryList({QStringLiteral("*.qss")}, QDir::Files, QDir::Name);
+        for (const QString& name : files) {
+            QFile f(dir.filePath(name));
+            if (!f.open(QIODevice::ReadOnly)) {
+                std::fprintf(stderr, "qfw_qss_compiler: cannot read %s\n",
+                             qPrintable(f.fileName()));
+                return 1;
+            }
+
+            const QString qss = QString::fromUtf8(f.readAll());
+            templates.append(qMakePair(
+                QStringLiteral(":/qfluentwidgets/qss/") + theme + QLatin1Char('/') + name,
+                QssTemplate::compile(rewriter.rewrite(qss))));
+        }
+    }
+
+    const QByteArray blob = writeQssTemplateBundle(templates, rewriter.signature());
+
+    QByteArray source;
+    source += "// Generated by qfw_qss_compiler. Do not edit.\n";
+    source += "#include <QByteArray>\n\n";
+    source += "namespace qfw {\n\n";
+    source += "static const unsigned char kPrecompiledQss[] = {";
+    for (int i = 0; i < blob.size(); ++i) {
+        source += (i % 16 == 0) ? "\n    " : " ";
+        source += "0x" + QByteArray::number(static_cast<uchar>(blob.at(i)), 16).rightJustified(2, '0') +
+                  ',';
+    }
+    source += "\n};\n\n";
+    source += "QByteArray precompiledQssBlob() {\n";
+    source += "    return QByteArray::fromRawData(reinterpret_cast<const char*>(kPrecompiledQss),\n";
+    source += "                                   sizeof(kPrecompiledQss));\n";
+    source += "}\n\n";
+    source += "}  // namespace qfw\n";
+
+    QSaveFile file(outputPath);
+    if (!file.open(QIODevice::WriteOnly) || file.write(source) != source.size() || !file.commit()) {
+        std::fprintf(stderr, "qfw_qss_compiler: cannot write %s\n", qPrintable(outputPath));
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,269 @@
+// Equivalence check and micro-benchmark for the QSS selector rewriter.
+//
+// Usage: qfw_qss_rewriter_check <qss-dir> [iterations]
+//
+// Renders every <qss-dir>/{light,dark}/*.qss through the current pipeline (QssSelectorRewriter,
+// then QssTemplate token substitution) and through a copy of the regex based fixTypeSelectors()
+// it replaced (token substitution first, then one regex per type). The outputs must be equal;
+// this covers both behaviour changes of the rewrite: selectors are now rewritten before the
+// tokens are substituted, and the special rules (RoundMenu, ComboBox, InfoBar, ...) are no
+// longer applied inside qssClass="..." values. Exits with 1 on the first differing sheet, after
+// printing the differing line. Then times both paths over all sheets.
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QRegularExpression>
+#include <QSet>
+#include <QStringList>
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include "common/qss_template.h"
+
+using namespace qfw;
+
+namespace {
+
+// The type list of the old fixTypeSelectors(), kept verbatim so a drift in the rewriter's
+// table shows up as a difference.
+const QStringList& legacyClassTypes() {
+    static const QStringList types = {
+        QStringLiteral("LineEdit"),
+        QStringLiteral("TextEdit"),
+        QStringLiteral("PlainTextEdit"),
+        QStringLiteral("TextBrowser"),
+        QStringLiteral("InfoBadge"),
+        QStringLiteral("PrimaryPushButton"),
+        QStringLiteral("PrimaryToolButton"),
+        QStringLiteral("PrimaryDropDownPushButton"),
+        QStringLiteral("PrimaryDropDownToolButton"),
+        QStringLiteral("TransparentPushButton"),
+        QStringLiteral("TransparentToolButton"),
+        QStringLiteral("TransparentTogglePushButton"),
+        QStringLiteral("TransparentToggleToolButton"),
+        QStringLiteral("TransparentDropDownPushButton"),
+        QStringLiteral("TransparentDropDownToolButton"),
+        QStringLiteral("ToggleButton"),
+        QStringLiteral("ToggleToolButton"),
+        QStringLiteral("TogglePushButton"),
+        QStringLiteral("DropDownPushButton"),
+        QStringLiteral("DropDownToolButton"),
+        QStringLiteral("HyperlinkButton"),
+        QStringLiteral("HyperlinkLabel"),
+        QStringLiteral("ToolButton"),
+        QStringLiteral("RadioButton"),
+        QStringLiteral("PillPushButton"),
+        QStringLiteral("PillToolButton"),
+        QStringLiteral("SplitDropButton"),
+        QStringLiteral("PrimarySplitDropButton"),
+        QStringLiteral("PushButton"),
+        QStringLiteral("TabBar"),
+        QStringLiteral("SimpleCardWidget"),
+        QStringLiteral("ElevatedCardWidget"),
+        QStringLiteral("HeaderCardWidget"),
+        QStringLiteral("GroupHeaderCardWidget"),
+        QStringLiteral("StateToolTip"),
+        QStringLiteral("ToastToolTip"),
+        QStringLiteral("SpinBox"),
+        QStringLiteral("DoubleSpinBox"),
+        QStringLiteral("CompactSpinBox"),
+        QStringLiteral("CompactDoubleSpinBox"),
+        QStringLiteral("SpinButton"),
+        QStringLiteral("DateEdit"),
+        QStringLiteral("DateTimeEdit"),
+        QStringLiteral("TimeEdit"),
+        QStringLiteral("PivotItem"),
+        QStringLiteral("Pivot"),
+        QStringLiteral("SegmentedItem"),
+        QStringLiteral("SegmentedToolItem"),
+        QStringLiteral("SegmentedWidget"),
+        QStringLiteral("SegmentedToolWidget"),
+        QStringLiteral("SegmentedToggleToolItem"),
+        QStringLiteral("SegmentedToggleToolWidget"),
+        QStringLiteral("ScrollButton"),
+        QStringLiteral("CalendarPicker"),
+        QStringLiteral("CalendarViewBase"),
+        QStringLiteral("ScrollViewBase"),
+        QStringLiteral("CycleListWidget"),
+        QStringLiteral("PickerPanel"),
+        QStringLiteral("SeparatorWidget"),
+        QStringLiteral("ItemMaskWidget"),
+        QStringLiteral("PickerBase"),
+        QStringLiteral("DatePicker"),
+        QStringLiteral("ZhDatePicker"),
+        QStringLiteral("SettingCard"),
+        QStringLiteral("SwitchSettingCard"),
+        QStringLiteral("RangeSettingCard"),
+        QStringLiteral("PushSettingCard"),
+        QStringLiteral("PrimaryPushSettingCard"),
+        QStringLiteral("HyperlinkCard"),
+        QStringLiteral("ColorPickerButton"),
+        QStringLiteral("ColorSettingCard"),
+        QStringLiteral("ComboBoxSettingCard"),
+        QStringLiteral("SettingCardGroup"),
+        QStringLiteral("ExpandSettingCard"),
+        QStringLiteral("ExpandGroupSettingCard"),
+        QStringLiteral("SimpleExpandGroupSettingCard"),
+        QStringLiteral("CustomColorSettingCard"),
+        QStringLiteral("OptionsSettingCard"),
+        QStringLiteral("FolderListSettingCard"),
+        QStringLiteral("StackedWidget"),
+        QStringLiteral("FluentTitleBar"),
+        QStringLiteral("SplitTitleBar"),
+        QStringLiteral("MSFluentTitleBar"),
+        QStringLiteral("FluentLabelBase"),
+        QStringLiteral("CaptionLabel"),
+        QStringLiteral("BodyLabel"),
+        QStringLiteral("StrongBodyLabel"),
+        QStringLiteral("SubtitleLabel"),
+        QStringLiteral("TitleLabel"),
+        QStringLiteral("LargeTitleLabel"),
+        QStringLiteral("DisplayLabel"),
+    };
+    return types;
+}
+
+QString legacyFixTypeSelectors(const QString& qss) {
+    static QHash<QString, QRegularExpression> regexCache;
+    QString result = qss;
+
+    const QSet<QString> allTypes(legacyClassTypes().cbegin(), legacyClassTypes().cend());
+    for (const QString& type : allTypes) {
+        if (!result.contains(type)) {
+            continue;
+        }
+        auto it = regexCache.constFind(type);
+        if (it == regexCache.constEnd()) {
+            it = regexCache.insert(type, QRegularExpression(QStringLiteral("(?<!qssClass=\")\\b") +
+                                                            type + QStringLiteral("\\b")));
+        }
+        result.replace(it.value(), QStringLiteral("*[qssClass=\"") + type + QStringLiteral("\"]"));
+    }
+
+    result.replace(QRegularExpression(QStringLiteral("\\bRoundMenu\\b")),
+                   QStringLiteral("QMenu[qssClass=\"RoundMenu\"]"));
+    result.replace(QRegularExpression(QStringLiteral("\\bMenuActionListWidget\\b")),
+                   QStringLiteral("QListWidget[qssClass=\"MenuActionListWidget\"]"));
+    result.replace(QRegularExpression(QStringLiteral("\\bComboBox\\b")),
+                   QStringLiteral("*[comboBox=true]"));
+    result.replace(QRegularExpression(QStringLiteral("\\bModelComboBox\\b")),
+                   QStringLiteral("*[modelComboBox=true]"));
+    result.replace(QRegularExpression(QStringLiteral("\\bInfoBar\\b")),
+                   QStringLiteral("*[infoBar=true]"));
+    return result;
+}
+
+// Real font families and stand-in colors; the colors only need to be distinct.
+QssTemplate::TokenValues tokenValues() {
+    QssTemplate::TokenValues values;
+    values[QssTemplate::FontFamilies] =
+        QStringLiteral("'Segoe UI','Microsoft YaHei','PingFang SC'");
+    for (int t = QssTemplate::ThemeColorPrimary; t < QssTemplate::TokenCount; ++t) {
+        values[t] = QStringLiteral("#%1").arg(0x109faa + t * 0x010101, 6, 16, QLatin1Char('0'));
+    }
+    return values;
+}
+
+QString legacyRender(const QString& qss, const QssTemplate::TokenValues& values) {
+    QString result = qss;
+    for (int t = 0; t < QssTemplate::TokenCount; ++t) {
+        const auto token = static_cast<QssTemplate::Token>(t);
+        result.replace(QStringLiteral("--") + QssTemplate::tokenName(token), values[t]);
+    }
+    return legacyFixTypeSelectors(result);
+}
+
+QString currentRender(const QssSelectorRewriter& rewriter, const QString& qss,
+                      const QssTemplate::TokenValues& values) {
+    return QssTemplate::compile(rewriter.rewrite(qss)).render(values);
+}
+
+void printFirstDifference(const QString& expected, const QString& actual) {
+    const QStringList a = expected.split(QLatin1Char('\n'));
+    const QStringList b = actual.split(QLatin1Char('\n'));
+    for (int i = 0; i < std::max(a.size(), b.size()); ++i) {
+        const QString la = i < a.size() ? a.at(i) : QString();
+        const QString lb = i < b.size() ? b.at(i) : QString();
+        if (la != lb) {
+            std::fprintf(stderr, "  line %d\n  old: %s\n  new: %s\n", i + 1, qPrintable(la),
+                         qPrintable(lb));
+            return;
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() < 2) {
+        std::fprintf(stderr, "usage: qfw_qss_rewriter_check <qss-dir> [iterations]\n");
+        return 2;
+    }
+    const QDir root(args.at(1));
+    const int iterations = args.size() > 2 ? std::max(1, args.at(2).toInt()) : 50;
+
+    QStringList names;
+    QStringList sheets;
+    for (const QString& theme : {QStringLiteral("light"), QStringLiteral("dark")}) {
+        const QDir dir(root.filePath(theme));
+        const QStringList files = dir.entryList({QStringLiteral("*.qss")}, QDir::Files, QDir::Name);
+        for (const QString& name : files) {
+            QFile f(dir.filePath(name));
+            if (!f.open(QIODevice::ReadOnly)) {
+                std::fprintf(stderr, "qfw_qss_rewriter_check: cannot read %s\n",
+                             qPrintable(f.fileName()));
+                return 1;
+            }
+            names.append(theme + QLatin1Char('/') + name);
+            sheets.append(QString::fromUtf8(f.readAll()));
+        }
+    }
+    if (sheets.isEmpty()) {
+        std::fprintf(stderr, "qfw_qss_rewriter_check: no sheets in %s\n", qPrintable(root.path()));
+        return 1;
+    }
+
+    const QssTemplate::TokenValues values = tokenValues();
+    QssSelectorRewriter rewriter;
+    for (int i = 0; i < sheets.size(); ++i) {
+        const QString expected = legacyRender(sheets.at(i), values);
+        const QString actual = currentRender(rewriter, sheets.at(i), values);
+        if (expected != actual) {
+            std::fprintf(stderr, "%s: output differs from fixTypeSelectors\n",
+                         qPrintable(names.at(i)));
+            printFirstDifference(expected, actual);
+            return 1;
+        }
+    }
+    std::printf("%d sheets identical\n", static_cast<int>(sheets.size()));
+
+    // Both paths start from the raw sheets every time, as a cold cache or a theme switch does.
+    QElapsedTimer timer;
+    qint64 sink = 0;
+    timer.start();
+    for (int n = 0; n < iterations; ++n) {
+        for (const QString& qss : std::as_const(sheets)) {
+            sink += legacyRender(qss, values).size();
+        }
+    }
+    const double legacyMs = timer.nsecsElapsed() / 1e6 / iterations;
+
+    timer.start();
+    for (int n = 0; n < iterations; ++n) {
+        for (const QString& qss : std::as_const(sheets)) {
+            sink += currentRender(rewriter, qss, values).size();
+        }
+    }
+    const double currentMs = timer.nsecsElapsed() / 1e6 / iterations;
+
+    std::printf("all sheets, %d iterations: fixTypeSelectors %.3f ms, rewriter %.3f ms (%.1fx)\n",
+                iterations, legacyMs, currentMs, currentMs > 0 ? legacyMs / currentMs : 0.0);
+    return sink > 0 ? 0 : 1;
+}